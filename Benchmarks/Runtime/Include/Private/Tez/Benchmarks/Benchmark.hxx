@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Tez/Core/Types.hxx>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace Tez
+{
+// Makes the compiler assume value is read, so computing it can't be optimized away
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile Char* bytes = reinterpret_cast<const volatile Char*>(&value);
+    (void)*bytes;
+    _ReadWriteBarrier();
+#endif
+}
+
+// Makes the compiler assume all memory is read and written
+inline void ClobberMemory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    _ReadWriteBarrier();
+#endif
+}
+
+// Perf counters only count the calling thread, so bodies that spread their work over other
+// threads are measured without them
+enum class BenchmarkThreading
+{
+    SINGLE = 0, // everything runs on the calling thread
+    MULTI  = 1  // other threads do part of the work
+};
+
+struct BenchmarkOptions
+{
+    // Only benchmarks whose name contains this run
+    std::string filter{};
+    UInt32 samples{10};
+    // Iterations per sample are picked so one sample takes at least this long
+    Float64 minSampleSeconds{0.02};
+};
+
+struct BenchmarkResult
+{
+    std::string name{};
+    UInt64 iterations{0};
+    UInt64 itemsPerIteration{1};
+    BenchmarkThreading threading{BenchmarkThreading::SINGLE};
+    // Nanoseconds per item, one entry per sample
+    std::vector<Float64> samples{};
+    // Hardware counters per item, averaged over the samples, empty for multi threaded results
+    std::vector<std::pair<std::string, Float64>> counters{};
+    // Anything a benchmark reports on top, e.g. latency percentiles
+    std::vector<std::pair<std::string, Float64>> metrics{};
+};
+
+class BenchmarkContext
+{
+public:
+    explicit BenchmarkContext(BenchmarkOptions options);
+    ~BenchmarkContext();
+
+    BenchmarkContext(const BenchmarkContext&)            = delete;
+    BenchmarkContext& operator=(const BenchmarkContext&) = delete;
+
+    // Lets benchmarks skip expensive setup for filtered out cases
+    [[nodiscard]] bool IsEnabled(std::string_view name) const noexcept;
+
+    // body(iterations) runs the measured operation iterations times, each operation handling
+    // itemsPerIteration items. Results are reported per item.
+    template <typename Body>
+    void Measure(std::string_view name, Body&& body, UInt64 itemsPerIteration = 1,
+                 BenchmarkThreading threading = BenchmarkThreading::SINGLE)
+    {
+        if (!IsEnabled(name)) return;
+        MeasureErased(
+            name, itemsPerIteration, threading,
+            [](void* erased, UInt64 iterations) { (*static_cast<Body*>(erased))(iterations); },
+            &body);
+    }
+
+    // For benchmarks that take their own samples, e.g. latencies
+    void Record(BenchmarkResult result);
+
+    [[nodiscard]] const BenchmarkOptions& GetOptions() const noexcept { return _options; }
+    [[nodiscard]] const std::vector<BenchmarkResult>& GetResults() const noexcept
+    {
+        return _results;
+    }
+
+    // Machine readable results, see Scripts/CompareBenchmarks.py
+    bool WriteJson(const std::string& path) const;
+
+private:
+    class PerfCounters;
+
+    void MeasureErased(std::string_view name, UInt64 itemsPerIteration,
+                       BenchmarkThreading threading, void (*run)(void*, UInt64), void* body);
+
+    BenchmarkOptions _options{};
+    std::unique_ptr<PerfCounters> _perfCounters{};
+    std::vector<BenchmarkResult> _results{};
+};
+
+// One group per source file, run in this order by Main.cxx
+void RunVectorBenchmarks(BenchmarkContext& context);
+void RunContainerBenchmarks(BenchmarkContext& context);
+void RunHashMapBenchmarks(BenchmarkContext& context);
+void RunTypeBenchmarks(BenchmarkContext& context);
+void RunMemoryBenchmarks(BenchmarkContext& context);
+void RunJobBenchmarks(BenchmarkContext& context);
+void RunLogBenchmarks(BenchmarkContext& context);
+void RunProfilerBenchmarks(BenchmarkContext& context);
+} // namespace Tez
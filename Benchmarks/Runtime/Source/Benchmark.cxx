@@ -0,0 +1,394 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/Config.hxx>
+#include <Tez/Core/Simd.hxx>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+
+#if defined(TEZ_PLATFORM_LINUX)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace Tez
+{
+namespace
+{
+struct SampleSummary
+{
+    Float64 median{0.0};
+    Float64 mean{0.0};
+    Float64 stddev{0.0};
+    Float64 min{0.0};
+};
+
+SampleSummary Summarize(std::vector<Float64> samples)
+{
+    SampleSummary summary;
+    if (samples.empty()) return summary;
+
+    std::sort(samples.begin(), samples.end());
+    const UInt64 count = samples.size();
+    summary.median     = count % 2 ? samples[count / 2]
+                                   : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+    summary.min        = samples.front();
+
+    for (const Float64 sample : samples) summary.mean += sample;
+    summary.mean /= static_cast<Float64>(count);
+
+    if (count > 1)
+    {
+        Float64 squares = 0.0;
+        for (const Float64 sample : samples)
+            squares += (sample - summary.mean) * (sample - summary.mean);
+        summary.stddev = std::sqrt(squares / static_cast<Float64>(count - 1));
+    }
+    return summary;
+}
+
+void WriteJsonString(std::FILE* file, std::string_view text)
+{
+    std::fputc('"', file);
+    for (const Char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            std::fputc('\\', file);
+            std::fputc(c, file);
+        }
+        else if (static_cast<UInt8>(c) < 0x20)
+        {
+            std::fprintf(file, "\\u%04x", static_cast<UInt32>(c));
+        }
+        else
+        {
+            std::fputc(c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+
+// JSON has no NaN or infinity
+void WriteJsonNumber(std::FILE* file, Float64 value)
+{
+    if (std::isfinite(value))
+        std::fprintf(file, "%.6g", static_cast<double>(value));
+    else
+        std::fputs("null", file);
+}
+
+void WriteJsonPairs(std::FILE* file, const std::vector<std::pair<std::string, Float64>>& pairs)
+{
+    std::fputc('{', file);
+    for (UInt64 i = 0; i < pairs.size(); i++)
+    {
+        if (i) std::fputc(',', file);
+        WriteJsonString(file, pairs[i].first);
+        std::fputc(':', file);
+        WriteJsonNumber(file, pairs[i].second);
+    }
+    std::fputc('}', file);
+}
+
+const Char* GetSimdName()
+{
+#if defined(TEZ_SIMD_AVX2)
+    return "avx2";
+#elif defined(TEZ_SIMD_SSE)
+    return "sse";
+#else
+    return "off";
+#endif
+}
+} // namespace
+
+// Counts user space events of the calling thread through perf_event_open. Counters the kernel
+// or the CPU don't offer are left out, without any the context just reports times.
+class BenchmarkContext::PerfCounters
+{
+public:
+    static constexpr UInt32 MaxCounters = 4;
+
+    PerfCounters()
+    {
+#if defined(TEZ_PLATFORM_LINUX)
+        struct Event
+        {
+            const Char* name;
+            UInt64 config;
+        };
+        constexpr Event events[MaxCounters] = {{"cycles", PERF_COUNT_HW_CPU_CYCLES},
+                                               {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+                                               {"cache_misses", PERF_COUNT_HW_CACHE_MISSES},
+                                               {"branch_misses", PERF_COUNT_HW_BRANCH_MISSES}};
+
+        for (const Event& event : events)
+        {
+            perf_event_attr attr{};
+            attr.size           = sizeof(attr);
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.config         = event.config;
+            attr.disabled       = _leader < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format =
+                PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const Int32 fd =
+                static_cast<Int32>(syscall(SYS_perf_event_open, &attr, 0, -1, _leader, 0));
+            if (fd < 0) continue;
+
+            if (_leader < 0) _leader = fd;
+            _fds[_count]     = fd;
+            _names[_count++] = event.name;
+        }
+#endif
+    }
+
+    ~PerfCounters()
+    {
+#if defined(TEZ_PLATFORM_LINUX)
+        for (UInt32 i = 0; i < _count; i++) close(_fds[i]);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    [[nodiscard]] UInt32 GetCount() const noexcept { return _count; }
+    [[nodiscard]] const Char* GetName(UInt32 index) const noexcept { return _names[index]; }
+
+    void Start() noexcept
+    {
+#if defined(TEZ_PLATFORM_LINUX)
+        if (_count == 0) return;
+        ioctl(_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    // Counts since Start, scaled up if the kernel multiplexed them with other events. False when
+    // they never got to run.
+    bool Stop(std::array<Float64, MaxCounters>& values) noexcept
+    {
+#if defined(TEZ_PLATFORM_LINUX)
+        if (_count == 0) return false;
+        ioctl(_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        struct
+        {
+            UInt64 count;
+            UInt64 timeEnabled;
+            UInt64 timeRunning;
+            UInt64 values[MaxCounters];
+        } group{};
+        if (read(_leader, &group, sizeof(group)) <= 0 || group.timeRunning == 0) return false;
+
+        const Float64 scale =
+            static_cast<Float64>(group.timeEnabled) / static_cast<Float64>(group.timeRunning);
+        for (UInt32 i = 0; i < _count; i++)
+            values[i] = static_cast<Float64>(group.values[i]) * scale;
+        return true;
+#else
+        (void)values;
+        return false;
+#endif
+    }
+
+private:
+    Int32 _leader{-1};
+    UInt32 _count{0};
+    std::array<Int32, MaxCounters> _fds{};
+    std::array<const Char*, MaxCounters> _names{};
+};
+
+BenchmarkContext::BenchmarkContext(BenchmarkOptions options)
+    : _options{std::move(options)}
+    , _perfCounters{std::make_unique<PerfCounters>()}
+{
+    std::printf("%-64s %14s %8s", "Benchmark", "ns/item", "rsd");
+    if (_perfCounters->GetCount() > 0) std::printf(" %10s %6s", "cycles", "IPC");
+    std::printf("\n");
+}
+
+BenchmarkContext::~BenchmarkContext() = default;
+
+bool BenchmarkContext::IsEnabled(std::string_view name) const noexcept
+{
+    return name.find(_options.filter) != std::string_view::npos;
+}
+
+void BenchmarkContext::MeasureErased(std::string_view name, UInt64 itemsPerIteration,
+                                     BenchmarkThreading threading, void (*run)(void*, UInt64),
+                                     void* body)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto time = [&](UInt64 iterations)
+    {
+        const auto begin = Clock::now();
+        run(body, iterations);
+        return std::chrono::duration<Float64>(Clock::now() - begin).count();
+    };
+
+    // Doubles as the warm up
+    UInt64 iterations = 1;
+    while (true)
+    {
+        const Float64 elapsed = time(iterations);
+        if (elapsed >= _options.minSampleSeconds) break;
+
+        const Float64 estimate =
+            elapsed > 0.0 ? _options.minSampleSeconds * 1.2 / elapsed : 10.0;
+        iterations = static_cast<UInt64>(static_cast<Float64>(iterations) *
+                                         std::clamp<Float64>(estimate, 2.0, 10.0));
+    }
+
+    BenchmarkResult result{.name              = std::string(name),
+                           .iterations        = iterations,
+                           .itemsPerIteration = itemsPerIteration,
+                           .threading         = threading};
+    const Float64 items = static_cast<Float64>(iterations * itemsPerIteration);
+
+    // Other threads' events would be missing from the counts
+    const bool counted = threading == BenchmarkThreading::SINGLE;
+
+    std::array<Float64, PerfCounters::MaxCounters> counterTotals{};
+    UInt32 countedSamples = 0;
+    for (UInt32 sample = 0; sample < std::max(_options.samples, 1u); sample++)
+    {
+        std::array<Float64, PerfCounters::MaxCounters> counters{};
+        if (counted) _perfCounters->Start();
+        const Float64 elapsed = time(iterations);
+        if (counted && _perfCounters->Stop(counters))
+        {
+            for (UInt32 i = 0; i < _perfCounters->GetCount(); i++) counterTotals[i] += counters[i];
+            countedSamples++;
+        }
+        result.samples.push_back(elapsed * 1e9 / items);
+    }
+
+    if (countedSamples > 0)
+    {
+        for (UInt32 i = 0; i < _perfCounters->GetCount(); i++)
+            result.counters.emplace_back(_perfCounters->GetName(i),
+                                         counterTotals[i] / (items * countedSamples));
+    }
+    Record(std::move(result));
+}
+
+void BenchmarkContext::Record(BenchmarkResult result)
+{
+    const SampleSummary summary = Summarize(result.samples);
+    const Float64 relativeStddev = summary.mean > 0.0 ? summary.stddev / summary.mean : 0.0;
+    std::printf("%-64s %14.3f %7.2f%%", result.name.c_str(), static_cast<double>(summary.median),
+                static_cast<double>(relativeStddev * 100.0));
+
+    Float64 cycles       = -1.0;
+    Float64 instructions = -1.0;
+    for (const auto& [counter, value] : result.counters)
+    {
+        if (counter == "cycles") cycles = value;
+        if (counter == "instructions") instructions = value;
+    }
+    if (cycles >= 0.0) std::printf(" %10.2f", static_cast<double>(cycles));
+    if (cycles > 0.0 && instructions >= 0.0)
+        std::printf(" %6.2f", static_cast<double>(instructions / cycles));
+
+    for (const auto& [metric, value] : result.metrics)
+        std::printf(" %s=%.3f", metric.c_str(), static_cast<double>(value));
+    std::printf("\n");
+    std::fflush(stdout);
+
+    _results.push_back(std::move(result));
+}
+
+bool BenchmarkContext::WriteJson(const std::string& path) const
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+    {
+        std::fprintf(stderr, "Could not open %s\n", path.c_str());
+        return false;
+    }
+
+    Char date[32] = {};
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#if defined(__clang__)
+    const Char* compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const Char* compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    const Char* compiler = "msvc";
+#endif
+
+#if defined(TEZ_BENCHMARK_CONFIG)
+    const Char* config = TEZ_BENCHMARK_CONFIG;
+#else
+    const Char* config = "";
+#endif
+
+    std::fputs("{\n\"context\":{\"date\":", file);
+    WriteJsonString(file, date);
+    std::fputs(",\"compiler\":", file);
+    WriteJsonString(file, compiler);
+    std::fputs(",\"config\":", file);
+    WriteJsonString(file, config);
+    std::fprintf(file, ",\"simd\":\"%s\",\"hardware_threads\":%u,\"samples\":%u,", GetSimdName(),
+                 std::thread::hardware_concurrency(), _options.samples);
+    std::fputs("\"min_sample_seconds\":", file);
+    WriteJsonNumber(file, _options.minSampleSeconds);
+    std::fputs(",\"perf_counters\":[", file);
+    for (UInt32 i = 0; i < _perfCounters->GetCount(); i++)
+    {
+        if (i) std::fputc(',', file);
+        WriteJsonString(file, _perfCounters->GetName(i));
+    }
+    // They only ever count the benchmark's calling thread
+    std::fputs("],\"perf_counter_scope\":\"calling_thread\"},\n\"benchmarks\":[", file);
+
+    for (UInt64 i = 0; i < _results.size(); i++)
+    {
+        const BenchmarkResult& result = _results[i];
+        const SampleSummary summary   = Summarize(result.samples);
+
+        std::fprintf(file, "%s\n{\"name\":", i ? "," : "");
+        WriteJsonString(file, result.name);
+        std::fprintf(file,
+                     ",\"unit\":\"ns\",\"iterations\":%llu,\"items_per_iteration\":%llu,"
+                     "\"multi_threaded\":%s,\"median\":",
+                     static_cast<unsigned long long>(result.iterations),
+                     static_cast<unsigned long long>(result.itemsPerIteration),
+                     result.threading == BenchmarkThreading::MULTI ? "true" : "false");
+        WriteJsonNumber(file, summary.median);
+        std::fputs(",\"mean\":", file);
+        WriteJsonNumber(file, summary.mean);
+        std::fputs(",\"stddev\":", file);
+        WriteJsonNumber(file, summary.stddev);
+        std::fputs(",\"min\":", file);
+        WriteJsonNumber(file, summary.min);
+        std::fputs(",\"samples\":[", file);
+        for (UInt64 s = 0; s < result.samples.size(); s++)
+        {
+            if (s) std::fputc(',', file);
+            WriteJsonNumber(file, result.samples[s]);
+        }
+        std::fputs("],\"counters\":", file);
+        WriteJsonPairs(file, result.counters);
+        std::fputs(",\"metrics\":", file);
+        WriteJsonPairs(file, result.metrics);
+        std::fputc('}', file);
+    }
+
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
+} // namespace Tez
@@ -0,0 +1,138 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/Array.hxx>
+#include <Tez/Core/Vector4.hxx>
+#include <string>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+constexpr UInt64 FillSize = 4096;
+
+template <typename Container>
+void PushBack(Container& container, UInt64 value)
+{
+    if constexpr (requires { container.PushBack(value); })
+        container.PushBack(value);
+    else
+        container.push_back(value);
+}
+
+template <typename Container>
+void EmplaceBack(Container& container, Float32 value)
+{
+    if constexpr (requires { container.EmplaceBack(value, value, value, value); })
+        container.EmplaceBack(value, value, value, value);
+    else
+        container.emplace_back(value, value, value, value);
+}
+
+template <typename Container>
+UInt64 GetSize(const Container& container)
+{
+    if constexpr (requires { container.Size(); })
+        return container.Size();
+    else
+        return container.size();
+}
+
+// The same operations on DynamicArray and std::vector, DynamicArray wraps std::vector so any
+// gap is overhead of the wrapper
+template <template <typename> typename Container>
+void RunSequenceBenchmarks(BenchmarkContext& context, const std::string& containerName,
+                           UInt64 count)
+{
+    const std::string prefix = "Container/" + containerName + "/";
+    const std::string suffix = "/" + std::to_string(count);
+
+    context.Measure(
+        prefix + "PushBack" + suffix,
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                Container<UInt64> container;
+                for (UInt64 i = 0; i < count; i++) PushBack(container, i);
+                DoNotOptimize(container);
+            }
+        },
+        count);
+
+    context.Measure(
+        prefix + "EmplaceBack" + suffix,
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                Container<Vector4f32> container;
+                for (UInt64 i = 0; i < count; i++)
+                    EmplaceBack(container, static_cast<Float32>(i));
+                DoNotOptimize(container);
+            }
+        },
+        count);
+
+    Container<UInt64> values;
+    for (UInt64 i = 0; i < count; i++) PushBack(values, i);
+    context.Measure(
+        prefix + "Iterate" + suffix,
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                UInt64 sum = 0;
+                for (const UInt64 value : values) sum += value;
+                DoNotOptimize(sum);
+                ClobberMemory();
+            }
+        },
+        GetSize(values));
+}
+
+template <typename T>
+using StdVector = std::vector<T>;
+
+template <typename T>
+using TezDynamicArray = DynamicArray<T>;
+
+void RunFillBenchmarks(BenchmarkContext& context)
+{
+    static Array<UInt64, FillSize> array{};
+
+    context.Measure(
+        "Container/Array/Fill/Value",
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                array.Fill(it);
+                DoNotOptimize(array);
+            }
+        },
+        FillSize);
+
+    context.Measure(
+        "Container/Array/Fill/Callable",
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                array.Fill([it](UInt64 index) { return index * it; });
+                DoNotOptimize(array);
+            }
+        },
+        FillSize);
+}
+} // namespace
+
+void RunContainerBenchmarks(BenchmarkContext& context)
+{
+    for (const UInt64 count : {UInt64{1024}, UInt64{1} << 20})
+    {
+        RunSequenceBenchmarks<TezDynamicArray>(context, "DynamicArray", count);
+        RunSequenceBenchmarks<StdVector>(context, "std::vector", count);
+    }
+    RunFillBenchmarks(context);
+}
+} // namespace Tez
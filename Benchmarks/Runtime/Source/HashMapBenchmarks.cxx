@@ -0,0 +1,115 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/HashMap.hxx>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+constexpr UInt64 MapSizes[] = {16, 256, 4096, 65536, 1 << 20, 10'000'000};
+
+std::vector<UInt64> MakeKeys(UInt64 count, UInt64 seed)
+{
+    std::mt19937_64 random(seed);
+    std::vector<UInt64> keys(count);
+    for (UInt64& key : keys) key = random();
+    return keys;
+}
+
+template <typename Map>
+bool Contains(const Map& map, UInt64 key)
+{
+    if constexpr (requires { map.Contains(key); })
+        return map.Contains(key);
+    else
+        return map.find(key) != map.end();
+}
+
+template <typename Map>
+void Insert(Map& map, UInt64 key, UInt64 value)
+{
+    if constexpr (requires { map.Insert(key, value); })
+        map.Insert(key, value);
+    else
+        map.emplace(key, value);
+}
+
+template <typename Map>
+void RunMapBenchmarks(BenchmarkContext& context, const std::string& mapName, UInt64 size)
+{
+    const std::string prefix = "HashMap/" + mapName + "/";
+    const std::string suffix = "/" + std::to_string(size);
+
+    // Filling the large maps takes a while, skip it when every case is filtered out
+    const Char* cases[] = {"Insert", "LookupHit", "LookupMiss", "Iterate"};
+    if (std::none_of(std::begin(cases), std::end(cases), [&](const Char* name)
+                     { return context.IsEnabled(prefix + name + suffix); }))
+        return;
+
+    const std::vector<UInt64> keys   = MakeKeys(size, 1);
+    const std::vector<UInt64> misses = MakeKeys(size, 2);
+
+    context.Measure(
+        prefix + "Insert" + suffix,
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                Map map;
+                for (const UInt64 key : keys) Insert(map, key, key);
+                DoNotOptimize(map);
+            }
+        },
+        size);
+
+    Map map;
+    for (const UInt64 key : keys) Insert(map, key, key);
+
+    const auto measureLookups = [&](const std::string& name, const std::vector<UInt64>& lookups)
+    {
+        context.Measure(
+            prefix + name + suffix,
+            [&](UInt64 iterations)
+            {
+                for (UInt64 it = 0; it < iterations; it++)
+                {
+                    UInt64 found = 0;
+                    for (const UInt64 key : lookups) found += Contains(map, key);
+                    DoNotOptimize(found);
+                }
+            },
+            size);
+    };
+    measureLookups("LookupHit", keys);
+    measureLookups("LookupMiss", misses);
+
+    context.Measure(
+        prefix + "Iterate" + suffix,
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                UInt64 sum = 0;
+                for (const auto& [key, value] : map) sum += value;
+                DoNotOptimize(sum);
+            }
+        },
+        size);
+}
+} // namespace
+
+void RunHashMapBenchmarks(BenchmarkContext& context)
+{
+    for (const UInt64 size : MapSizes)
+    {
+        RunMapBenchmarks<FlatHashMap<UInt64, UInt64>>(context, "FlatHashMap", size);
+        RunMapBenchmarks<std::unordered_map<UInt64, UInt64>>(context, "std::unordered_map",
+                                                              size);
+    }
+}
+} // namespace Tez
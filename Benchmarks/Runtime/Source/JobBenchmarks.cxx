@@ -0,0 +1,124 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/Array.hxx>
+#include <Tez/Core/JobSystem.hxx>
+#include <Tez/Core/Vector4.hxx>
+#include <algorithm>
+#include <atomic>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+constexpr UInt64 ParticleCount = 1 << 20;
+constexpr Float32 DeltaTime    = 0.016f;
+
+// Layers of tiny jobs, each waiting on two jobs of the layer before
+constexpr UInt64 GraphLayers = 16;
+constexpr UInt64 GraphWidth  = 256;
+
+constexpr UInt64 EmptyJobCount = 4096;
+
+std::vector<UInt32> GetWorkerCounts()
+{
+    const UInt32 hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::vector<UInt32> counts;
+    for (UInt32 count = 1; count < hardwareThreads; count *= 2) counts.push_back(count);
+    counts.push_back(hardwareThreads);
+    return counts;
+}
+
+void RunScalingBenchmarks(BenchmarkContext& context, UInt32 workerCount,
+                          DynamicArray<Vector4f32>& positions,
+                          const DynamicArray<Vector4f32>& velocities)
+{
+    const std::string suffix = "/" + std::to_string(workerCount);
+    const Char* cases[]      = {"Job/ParallelFor/Vector4f32", "Job/Graph", "Job/Schedule/Empty"};
+    if (std::none_of(std::begin(cases), std::end(cases),
+                     [&](const Char* name) { return context.IsEnabled(name + suffix); }))
+        return;
+
+    JobSystem jobs(workerCount);
+    // A single worker is the calling thread
+    const BenchmarkThreading threading =
+        workerCount > 1 ? BenchmarkThreading::MULTI : BenchmarkThreading::SINGLE;
+
+    context.Measure(
+        "Job/ParallelFor/Vector4f32" + suffix,
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                ParallelFor(jobs, ParticleCount,
+                            [&](UInt64 begin, UInt64 end)
+                            {
+                                Vector4f32* position       = positions.Data();
+                                const Vector4f32* velocity = velocities.Data();
+                                for (UInt64 i = begin; i < end; i++)
+                                {
+                                    const Vector4f32 moved = position[i] + velocity[i] * DeltaTime;
+                                    position[i]            = moved.Normalized();
+                                }
+                            });
+                ClobberMemory();
+            }
+        },
+        ParticleCount, threading);
+
+    std::atomic<UInt64> counter{0};
+    context.Measure(
+        "Job/Graph" + suffix,
+        [&](UInt64 iterations)
+        {
+            std::vector<JobHandle> previous(GraphWidth);
+            std::vector<JobHandle> current(GraphWidth);
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                for (UInt64 layer = 0; layer < GraphLayers; layer++)
+                {
+                    for (UInt64 i = 0; i < GraphWidth; i++)
+                    {
+                        const JobHandle dependencies[] = {previous[i],
+                                                          previous[(i + 1) % GraphWidth]};
+                        current[i] = jobs.Schedule(
+                            [&counter] { counter.fetch_add(1, std::memory_order_relaxed); },
+                            layer ? std::span<const JobHandle>(dependencies)
+                                  : std::span<const JobHandle>());
+                    }
+                    std::swap(previous, current);
+                }
+
+                jobs.Wait(jobs.Schedule([] {}, previous));
+                for (JobHandle& handle : previous) handle = JobHandle();
+            }
+        },
+        GraphLayers * GraphWidth, threading);
+
+    context.Measure(
+        "Job/Schedule/Empty" + suffix,
+        [&](UInt64 iterations)
+        {
+            std::vector<JobHandle> handles(EmptyJobCount);
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                for (JobHandle& handle : handles) handle = jobs.Schedule([] {});
+                for (const JobHandle& handle : handles) jobs.Wait(handle);
+            }
+        },
+        EmptyJobCount, threading);
+}
+} // namespace
+
+void RunJobBenchmarks(BenchmarkContext& context)
+{
+    DynamicArray<Vector4f32> positions(ParticleCount, Vector4f32(1.0f, 0.0f, 0.0f, 0.0f));
+    const DynamicArray<Vector4f32> velocities(ParticleCount, Vector4f32(0.0f, 1.0f, 0.0f, 0.0f));
+
+    for (const UInt32 workerCount : GetWorkerCounts())
+        RunScalingBenchmarks(context, workerCount, positions, velocities);
+}
+} // namespace Tez
@@ -0,0 +1,163 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/Clock.hxx>
+#include <Tez/Core/Log.hxx>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+constexpr std::string_view Message = "Benchmark message of a typical length, frame 1234";
+
+// Channel types are unique per registry, hence the index
+template <UInt32 Index>
+class NullChannel : public ILogChannel
+{
+public:
+    void OnLogReceived(const LogEntry& log) override { DoNotOptimize(log.message.size()); }
+};
+
+template <UInt32... Indices>
+void AddChannels(LogSystem& logSystem, std::integer_sequence<UInt32, Indices...>)
+{
+    (logSystem.AddChannel<NullChannel<Indices>>(), ...);
+}
+
+void MeasureLog(BenchmarkContext& context, UInt32 channelCount)
+{
+    context.Measure("Log/Sync/Channels/" + std::to_string(channelCount),
+                    [](UInt64 iterations)
+                    {
+                        LogSystem& logSystem = LogSystem::GetInstance();
+                        for (UInt64 it = 0; it < iterations; it++)
+                            logSystem.Log(Message, LogType::INFO);
+                    });
+}
+
+// Nearest rank
+[[nodiscard]] Float64 Percentile(const std::vector<Float64>& sorted, UInt64 perMille)
+{
+    const UInt64 rank = std::max<UInt64>((sorted.size() * perMille + 999) / 1000, 1);
+    return sorted[rank - 1];
+}
+
+// Latency of the Log() call itself on every producer while all of them log at once
+void MeasureAsyncLatency(BenchmarkContext& context, UInt32 producerCount)
+{
+    constexpr UInt64 MessagesPerProducer = 20000;
+
+    const std::string prefix = "Log/Async/Producers/" + std::to_string(producerCount) + "/";
+    if (!context.IsEnabled(prefix + "p50") && !context.IsEnabled(prefix + "p99") &&
+        !context.IsEnabled(prefix + "Throughput"))
+        return;
+
+    LogSystem& logSystem = LogSystem::GetInstance();
+    logSystem.StartAsync(1 << 14, LogOverflowPolicy::BLOCK);
+
+    using Clock = std::chrono::steady_clock;
+
+    BenchmarkResult p50{.name       = prefix + "p50",
+                        .iterations = 1,
+                        .threading  = BenchmarkThreading::MULTI};
+    BenchmarkResult p99{.name       = prefix + "p99",
+                        .iterations = 1,
+                        .threading  = BenchmarkThreading::MULTI};
+    BenchmarkResult throughput{.name              = prefix + "Throughput",
+                               .iterations        = 1,
+                               .itemsPerIteration = MessagesPerProducer * producerCount,
+                               .threading         = BenchmarkThreading::MULTI};
+    Float64 worstP999 = 0.0;
+
+    std::vector<std::vector<UInt64>> ticks(producerCount,
+                                           std::vector<UInt64>(MessagesPerProducer));
+    std::vector<Float64> latencies;
+    latencies.reserve(MessagesPerProducer * producerCount);
+
+    for (UInt32 sample = 0; sample < std::max(context.GetOptions().samples, 1u); sample++)
+    {
+        std::atomic<UInt32> ready{0};
+        std::atomic<bool> start{false};
+        std::vector<std::thread> producers;
+        for (UInt32 p = 0; p < producerCount; p++)
+        {
+            producers.emplace_back(
+                [&, p]
+                {
+                    ready.fetch_add(1, std::memory_order_release);
+                    while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+
+                    for (UInt64& elapsed : ticks[p])
+                    {
+                        const UInt64 begin = ReadCycleCounter();
+                        logSystem.Log(Message, LogType::INFO);
+                        elapsed = ReadCycleCounter() - begin;
+                    }
+                });
+        }
+
+        // Throughput is timed on the steady clock, the calibration only converts latency ticks
+        while (ready.load(std::memory_order_acquire) < producerCount) std::this_thread::yield();
+        const ClockCalibration begin = ClockCalibration::Now();
+        const auto beginTime         = Clock::now();
+        start.store(true, std::memory_order_release);
+        for (std::thread& producer : producers) producer.join();
+        logSystem.Flush();
+        const Float64 elapsed =
+            std::chrono::duration<Float64, std::nano>(Clock::now() - beginTime).count();
+        const ClockCalibration end = ClockCalibration::Now();
+
+        const Float64 nanosecondsPerTick =
+            static_cast<Float64>(end.nanoseconds - begin.nanoseconds) /
+            static_cast<Float64>(std::max<UInt64>(end.ticks - begin.ticks, 1));
+
+        latencies.clear();
+        for (const std::vector<UInt64>& producerTicks : ticks)
+            for (const UInt64 elapsed : producerTicks)
+                latencies.push_back(static_cast<Float64>(elapsed) * nanosecondsPerTick);
+        std::sort(latencies.begin(), latencies.end());
+
+        p50.samples.push_back(Percentile(latencies, 500));
+        p99.samples.push_back(Percentile(latencies, 990));
+        worstP999 = std::max(worstP999, Percentile(latencies, 999));
+        throughput.samples.push_back(elapsed / static_cast<Float64>(throughput.itemsPerIteration));
+    }
+
+    logSystem.Shutdown();
+
+    p99.metrics.emplace_back("worst_p999", worstP999);
+    throughput.metrics.emplace_back("dropped", static_cast<Float64>(logSystem.GetDroppedCount()));
+    context.Record(std::move(p50));
+    context.Record(std::move(p99));
+    context.Record(std::move(throughput));
+}
+} // namespace
+
+void RunLogBenchmarks(BenchmarkContext& context)
+{
+    // Channels can't be removed, so the counts only go up. Nothing else in the benchmarks adds
+    // any.
+    LogSystem& logSystem = LogSystem::GetInstance();
+    MeasureLog(context, 0);
+
+    AddChannels(logSystem, std::integer_sequence<UInt32, 0>{});
+    MeasureLog(context, 1);
+
+    AddChannels(logSystem, std::integer_sequence<UInt32, 1, 2, 3>{});
+    MeasureLog(context, 4);
+
+    AddChannels(logSystem, std::integer_sequence<UInt32, 4, 5, 6, 7>{});
+    MeasureLog(context, 8);
+
+    // The async benchmarks drain into the channels added above
+    const UInt32 hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (const UInt32 producers : {8u, std::max(hardwareThreads, 16u)})
+        MeasureAsyncLatency(context, producers);
+}
+} // namespace Tez
@@ -0,0 +1,64 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace
+{
+void PrintUsage()
+{
+    std::printf("Usage: tez-benchmarks [--filter <text>] [--json <path>] [--samples <count>] "
+                "[--min-time <seconds>]\n");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Tez::BenchmarkOptions options;
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+
+        if (i + 1 >= argc)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        const char* value = argv[++i];
+        if (arg == "--filter")
+            options.filter = value;
+        else if (arg == "--json")
+            jsonPath = value;
+        else if (arg == "--samples")
+            options.samples = static_cast<Tez::UInt32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--min-time")
+            options.minSampleSeconds = std::strtod(value, nullptr);
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    Tez::BenchmarkContext context(options);
+    Tez::RunVectorBenchmarks(context);
+    Tez::RunContainerBenchmarks(context);
+    Tez::RunHashMapBenchmarks(context);
+    Tez::RunTypeBenchmarks(context);
+    Tez::RunMemoryBenchmarks(context);
+    Tez::RunJobBenchmarks(context);
+    Tez::RunLogBenchmarks(context);
+    Tez::RunProfilerBenchmarks(context);
+
+    if (!jsonPath.empty() && !context.WriteJson(jsonPath)) return 1;
+    return 0;
+}
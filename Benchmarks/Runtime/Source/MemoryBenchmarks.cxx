@@ -0,0 +1,107 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/FrameAllocator.hxx>
+#include <Tez/Core/LinearAllocator.hxx>
+#include <Tez/Core/PoolAllocator.hxx>
+#include <cstdlib>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+// One frame worth of short lived allocations, everything is freed at the end of the frame
+constexpr UInt64 AllocationsPerFrame = 1024;
+constexpr UInt64 MinAllocationSize   = 16;
+constexpr UInt64 MaxAllocationSize   = 256;
+constexpr UInt64 FrameCapacity       = AllocationsPerFrame * MaxAllocationSize * 2;
+
+std::vector<UInt64> MakeSizes()
+{
+    std::mt19937 random(7);
+    std::uniform_int_distribution<UInt64> distribution(MinAllocationSize, MaxAllocationSize);
+
+    std::vector<UInt64> sizes(AllocationsPerFrame);
+    for (UInt64& size : sizes) size = distribution(random);
+    return sizes;
+}
+
+// allocate(size) and release(pointers, sizes) run one frame each iteration, the first byte of
+// every allocation is written so pages are actually touched
+template <typename Allocate, typename Release>
+void MeasureFrames(BenchmarkContext& context, const std::string& name,
+                   const std::vector<UInt64>& sizes, Allocate allocate, Release release)
+{
+    std::vector<void*> pointers(sizes.size());
+    context.Measure(
+        "Memory/Frame/" + name,
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                for (UInt64 i = 0; i < sizes.size(); i++)
+                {
+                    pointers[i]                      = allocate(sizes[i]);
+                    *static_cast<Byte*>(pointers[i]) = Byte{1};
+                }
+                ClobberMemory();
+                release(pointers, sizes);
+            }
+        },
+        sizes.size());
+}
+} // namespace
+
+void RunMemoryBenchmarks(BenchmarkContext& context)
+{
+    const std::vector<UInt64> sizes = MakeSizes();
+
+    MeasureFrames(
+        context, "malloc", sizes, [](UInt64 size) { return std::malloc(size); },
+        [](std::vector<void*>& pointers, const std::vector<UInt64>&)
+        {
+            for (void* pointer : pointers) std::free(pointer);
+        });
+
+    LinearAllocator linear(FrameCapacity);
+    MeasureFrames(
+        context, "LinearAllocator", sizes, [&](UInt64 size) { return linear.Allocate(size); },
+        [&](std::vector<void*>&, const std::vector<UInt64>&) { linear.Reset(); });
+
+    FrameAllocator frames(FrameCapacity);
+    MeasureFrames(
+        context, "FrameAllocator", sizes, [&](UInt64 size) { return frames.Allocate(size); },
+        [&](std::vector<void*>&, const std::vector<UInt64>&) { frames.NextFrame(); });
+
+    PoolAllocator pool(MaxAllocationSize, AllocationsPerFrame);
+    MeasureFrames(
+        context, "PoolAllocator", sizes, [&](UInt64 size) { return pool.Allocate(size); },
+        [&](std::vector<void*>& pointers, const std::vector<UInt64>& allocationSizes)
+        {
+            for (UInt64 i = 0; i < pointers.size(); i++)
+                pool.Deallocate(pointers[i], allocationSizes[i]);
+        });
+
+    MeasureFrames(
+        context, "PoolAllocator/ThreadLocal", sizes,
+        [](UInt64 size) { return PoolAllocator::GetThreadLocal(size).Allocate(size); },
+        [](std::vector<void*>& pointers, const std::vector<UInt64>& allocationSizes)
+        {
+            for (UInt64 i = 0; i < pointers.size(); i++)
+                PoolAllocator::GetThreadLocal(allocationSizes[i])
+                    .Deallocate(pointers[i], allocationSizes[i]);
+        });
+
+    std::pmr::unsynchronized_pool_resource pmrPool;
+    MeasureFrames(
+        context, "std::pmr::unsynchronized_pool_resource", sizes,
+        [&](UInt64 size) { return pmrPool.allocate(size); },
+        [&](std::vector<void*>& pointers, const std::vector<UInt64>& allocationSizes)
+        {
+            for (UInt64 i = 0; i < pointers.size(); i++)
+                pmrPool.deallocate(pointers[i], allocationSizes[i]);
+        });
+}
+} // namespace Tez
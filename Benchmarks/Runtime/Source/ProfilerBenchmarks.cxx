@@ -0,0 +1,69 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/Profiler.hxx>
+#include <algorithm>
+
+namespace Tez
+{
+namespace
+{
+// Used directly so the benchmark runs whether or not TEZ_ENABLE_PROFILER is set
+constinit ProfileZone benchmarkZone{"Benchmark zone", __FILE__, __LINE__};
+
+// Well below the buffer size, so no zone is dropped between two collections
+constexpr UInt64 ZonesPerCollect = Profiler::ThreadBufferSize / 2;
+
+// Opening and closing one zone on a thread that already has its buffer
+void MeasureZone(BenchmarkContext& context)
+{
+    context.Measure("Profiler/Zone",
+                    [](UInt64 iterations)
+                    {
+                        Profiler& profiler = Profiler::GetInstance();
+                        for (UInt64 done = 0; done < iterations;)
+                        {
+                            const UInt64 batch = std::min(iterations - done, ZonesPerCollect);
+                            for (UInt64 it = 0; it < batch; it++)
+                            {
+                                ProfileScope scope(benchmarkZone);
+                                ClobberMemory();
+                            }
+                            done += batch;
+
+                            // Outside the zones, but still part of the measured time
+                            profiler.Collect();
+                            profiler.Clear();
+                        }
+                    });
+}
+
+// Moving a full batch of zones into the collected set
+void MeasureCollect(BenchmarkContext& context)
+{
+    context.Measure(
+        "Profiler/Collect",
+        [](UInt64 iterations)
+        {
+            Profiler& profiler = Profiler::GetInstance();
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                for (UInt64 zone = 0; zone < ZonesPerCollect; zone++)
+                    Profiler::Record(benchmarkZone, zone, zone + 1);
+                profiler.Collect();
+                profiler.Clear();
+            }
+        },
+        ZonesPerCollect);
+}
+} // namespace
+
+void RunProfilerBenchmarks(BenchmarkContext& context)
+{
+    // Registers the thread outside the measured time
+    Profiler::Record(benchmarkZone, 0, 0);
+    Profiler::GetInstance().Collect();
+    Profiler::GetInstance().Clear();
+
+    MeasureZone(context);
+    MeasureCollect(context);
+}
+} // namespace Tez
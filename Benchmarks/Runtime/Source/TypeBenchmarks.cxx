@@ -0,0 +1,45 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/HashMap.hxx>
+#include <Tez/Core/Types.hxx>
+#include <Tez/Core/Vector3.hxx>
+#include <string>
+#include <string_view>
+
+namespace Tez
+{
+namespace
+{
+using LongTypeName = FlatHashMap<UInt64, FlatHashMap<UInt64, Vector3<Float64>>>;
+
+// Calls go through volatile function pointers so the constexpr hash runs at run time, like it
+// does wherever it isn't constant folded
+template <typename Result, typename Func>
+void MeasureCall(BenchmarkContext& context, const std::string& name, Func* func)
+{
+    Func* volatile call = func;
+    context.Measure(name,
+                    [&](UInt64 iterations)
+                    {
+                        for (UInt64 it = 0; it < iterations; it++)
+                        {
+                            const Result result = call();
+                            DoNotOptimize(result);
+                        }
+                    });
+}
+
+template <typename T>
+void RunTypeCase(BenchmarkContext& context, const std::string& typeName)
+{
+    MeasureCall<UInt64>(context, "Type/TypeID/" + typeName, &TypeID<T>);
+    MeasureCall<std::string_view>(context, "Type/NameOf/" + typeName, &NameOf<T>);
+}
+} // namespace
+
+void RunTypeBenchmarks(BenchmarkContext& context)
+{
+    RunTypeCase<Int32>(context, "Int32");
+    RunTypeCase<Vector3f32>(context, "Vector3f32");
+    RunTypeCase<LongTypeName>(context, "FlatHashMap");
+}
+} // namespace Tez
@@ -0,0 +1,162 @@
+#include <Tez/Benchmarks/Benchmark.hxx>
+#include <Tez/Core/Array.hxx>
+#include <Tez/Core/Vector2.hxx>
+#include <Tez/Core/Vector3.hxx>
+#include <Tez/Core/Vector4.hxx>
+#include <Tez/Core/VectorStream.hxx>
+#include <random>
+#include <string>
+
+namespace Tez
+{
+namespace
+{
+// Small enough to stay in L1/L2, the operators are measured, not memory
+constexpr UInt64 VectorCount = 4096;
+// Large enough to stream from memory
+constexpr UInt64 StreamCount = 1 << 18;
+constexpr Float32 DeltaTime   = 0.016f;
+
+template <typename V>
+DynamicArray<V> MakeVectors(UInt64 count, UInt32 seed)
+{
+    using Scalar = typename VectorTraits<V>::Scalar;
+
+    // Away from zero so Normalized never divides by it. The standard distributions only take
+    // the standard floating point types.
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> distribution(0.5, 2.0);
+    const auto next = [&] { return static_cast<Scalar>(distribution(random)); };
+
+    DynamicArray<V> vectors;
+    vectors.Reserve(count);
+    for (UInt64 i = 0; i < count; i++)
+    {
+        if constexpr (VectorTraits<V>::Components == 2)
+            vectors.EmplaceBack(next(), next());
+        else if constexpr (VectorTraits<V>::Components == 3)
+            vectors.EmplaceBack(next(), next(), next());
+        else
+            vectors.EmplaceBack(next(), next(), next(), next());
+    }
+    return vectors;
+}
+
+template <typename V, typename Op>
+void MeasureBinary(BenchmarkContext& context, const std::string& name, const DynamicArray<V>& lhs,
+                   const DynamicArray<V>& rhs, Op op)
+{
+    using Result = decltype(op(lhs.Data()[0], rhs.Data()[0]));
+
+    DynamicArray<Result> out(lhs.Size());
+    context.Measure(
+        name,
+        [&](UInt64 iterations)
+        {
+            for (UInt64 it = 0; it < iterations; it++)
+            {
+                for (UInt64 i = 0; i < lhs.Size(); i++)
+                    out.Data()[i] = op(lhs.Data()[i], rhs.Data()[i]);
+                DoNotOptimize(out.Data());
+                ClobberMemory();
+            }
+        },
+        lhs.Size());
+}
+
+template <typename V>
+void RunVectorOperators(BenchmarkContext& context, const std::string& typeName)
+{
+    using Scalar = typename VectorTraits<V>::Scalar;
+
+    const std::string prefix = "Vector/" + typeName + "/";
+    const DynamicArray<V> lhs = MakeVectors<V>(VectorCount, 1);
+    const DynamicArray<V> rhs = MakeVectors<V>(VectorCount, 2);
+
+    MeasureBinary(context, prefix + "Add", lhs, rhs, [](V a, V b) { return a + b; });
+    MeasureBinary(context, prefix + "Subtract", lhs, rhs, [](V a, V b) { return a - b; });
+    MeasureBinary(context, prefix + "Multiply", lhs, rhs, [](V a, V b) { return a * b; });
+    MeasureBinary(context, prefix + "Scale", lhs, rhs,
+                  [](V a, V) { return a * static_cast<Scalar>(1.5); });
+    MeasureBinary(context, prefix + "Divide", lhs, rhs,
+                  [](V a, V) { return a / static_cast<Scalar>(1.5); });
+    MeasureBinary(context, prefix + "Dot", lhs, rhs, [](V a, V b) { return Dot(a, b); });
+    if constexpr (requires(V a) { Cross(a, a); })
+        MeasureBinary(context, prefix + "Cross", lhs, rhs, [](V a, V b) { return Cross(a, b); });
+    MeasureBinary(context, prefix + "Length", lhs, rhs, [](V a, V) { return a.Length(); });
+    MeasureBinary(context, prefix + "Normalized", lhs, rhs, [](V a, V) { return a.Normalized(); });
+}
+
+// Same kernels over an array of vectors and over a VectorStream
+void RunStreamComparison(BenchmarkContext& context)
+{
+    using V = Vector3f32;
+
+    const std::string prefix  = "VectorStream/Vector3f32/";
+    const DynamicArray<V> lhs = MakeVectors<V>(StreamCount, 3);
+    const DynamicArray<V> rhs = MakeVectors<V>(StreamCount, 4);
+    DynamicArray<V> out(StreamCount);
+    DynamicArray<Float32> dots(StreamCount);
+
+    const VectorStream<V> lhsStream(lhs);
+    const VectorStream<V> rhsStream(rhs);
+    VectorStream<V> outStream(StreamCount);
+
+    const auto measureAos = [&](const std::string& name, auto op)
+    {
+        context.Measure(
+            prefix + name + "/AoS",
+            [&](UInt64 iterations)
+            {
+                for (UInt64 it = 0; it < iterations; it++)
+                {
+                    for (UInt64 i = 0; i < StreamCount; i++) op(i);
+                    ClobberMemory();
+                }
+            },
+            StreamCount);
+    };
+
+    const auto measureSoa = [&](const std::string& name, auto kernel)
+    {
+        context.Measure(
+            prefix + name + "/SoA",
+            [&](UInt64 iterations)
+            {
+                for (UInt64 it = 0; it < iterations; it++)
+                {
+                    kernel();
+                    ClobberMemory();
+                }
+            },
+            StreamCount);
+    };
+
+    measureAos("Add", [&](UInt64 i) { out.Data()[i] = lhs.Data()[i] + rhs.Data()[i]; });
+    measureSoa("Add", [&] { Add(outStream, lhsStream, rhsStream); });
+
+    measureAos("MultiplyAdd",
+               [&](UInt64 i) { out.Data()[i] = lhs.Data()[i] * DeltaTime + rhs.Data()[i]; });
+    measureSoa("MultiplyAdd", [&] { MultiplyAdd(outStream, lhsStream, DeltaTime, rhsStream); });
+
+    measureAos("Dot", [&](UInt64 i) { dots.Data()[i] = Dot(lhs.Data()[i], rhs.Data()[i]); });
+    measureSoa("Dot", [&] { Dot(dots, lhsStream, rhsStream); });
+
+    measureAos("Cross", [&](UInt64 i) { out.Data()[i] = Cross(lhs.Data()[i], rhs.Data()[i]); });
+    measureSoa("Cross", [&] { Cross(outStream, lhsStream, rhsStream); });
+
+    measureAos("Normalize", [&](UInt64 i) { out.Data()[i] = lhs.Data()[i].Normalized(); });
+    measureSoa("Normalize", [&] { Normalize(outStream, lhsStream); });
+}
+} // namespace
+
+void RunVectorBenchmarks(BenchmarkContext& context)
+{
+    RunVectorOperators<Vector2f32>(context, "Vector2f32");
+    RunVectorOperators<Vector3f32>(context, "Vector3f32");
+    RunVectorOperators<Vector4f32>(context, "Vector4f32");
+    RunVectorOperators<Vector3f64>(context, "Vector3f64");
+    RunVectorOperators<Vector4f64>(context, "Vector4f64");
+    RunStreamComparison(context);
+}
+} // namespace Tez
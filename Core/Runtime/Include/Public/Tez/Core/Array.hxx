@@ -3,37 +3,43 @@
 #include "Assert.hxx"
 #include "Optional.hxx"
 #include "Types.hxx"
-#include <functional>
+#include <algorithm>
+#include <concepts>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Tez
 {
 template <typename T, UInt64 size>
 class Array
 {
-private:
-    using FillPred = std::function<T(UInt64 index)>;
-
 public:
     constexpr void Fill(const T& value)
     {
-        for (int i = 0; i < size; i++) data[i] = value;
+        for (UInt64 i = 0; i < size; i++) data[i] = value;
     }
 
-    constexpr void Fill(FillPred pred)
+    // pred(index) gives the element at index
+    template <typename Pred>
+        requires std::is_invocable_r_v<T, Pred&, UInt64>
+    constexpr void Fill(Pred&& pred)
     {
-        for (int i = 0; i < size; i++) data[i] = pred(i);
+        for (UInt64 i = 0; i < size; i++) data[i] = pred(i);
     }
 
     // operators
     [[nodiscard]] constexpr T& operator[](UInt64 pos) noexcept
     {
-        TEZ_SOFT_ASSERT(pos > size, "Index Out of Bounds!", T());
+        TEZ_HARD_ASSERT(pos < size, "Index Out of Bounds!");
         return data[pos];
     }
 
     [[nodiscard]] constexpr const T& operator[](UInt64 pos) const noexcept
     {
-        TEZ_SOFT_ASSERT(pos > size, "Index Out of Bounds!", T());
+        TEZ_HARD_ASSERT(pos < size, "Index Out of Bounds!");
         return data[pos];
     }
 
@@ -83,7 +89,7 @@ public:
     }
 
     [[nodiscard]]
-    constexpr const Allocator& GetAllocator() const noexcept
+    constexpr Allocator GetAllocator() const noexcept
     {
         return Base::get_allocator();
     }
@@ -113,13 +119,18 @@ public:
         Base::pop_back();
 
         if constexpr (std::is_pointer_v<T>)
-            return value ? std::move(value) : std::nullopt;
-        else
-            return std::move(value);
+        {
+            if (!value) return std::nullopt;
+        }
+        return value;
     }
 
     constexpr void Clear() noexcept { Base::clear(); }
 
+    constexpr void Reserve(SizeType capacity) { Base::reserve(capacity); }
+
+    constexpr void Resize(SizeType count) { Base::resize(count); }
+
     [[nodiscard]]
     constexpr SizeType Size() const noexcept
     {
@@ -134,13 +145,13 @@ public:
 
     [[nodiscard]] constexpr T& operator[](SizeType index) noexcept
     {
-        TEZ_SOFT_ASSERT(index > Base::size(), "Index Out of Bounds!", T());
+        TEZ_HARD_ASSERT(index < Base::size(), "Index Out of Bounds!");
         return Base::operator[](index);
     }
 
     constexpr const T& operator[](SizeType index) const noexcept
     {
-        TEZ_SOFT_ASSERT(index > Base::size(), "Index Out of Bounds!", T());
+        TEZ_HARD_ASSERT(index < Base::size(), "Index Out of Bounds!");
         return Base::operator[](index);
     }
 
@@ -204,4 +215,449 @@ public:
         return Base::end();
     }
 };
+
+// Uninitialized room for N elements, constructed and destroyed by the owning container
+template <typename T, UInt64 N,
+          bool Trivial = std::is_trivially_default_constructible_v<T> &&
+                         std::is_trivially_destructible_v<T>>
+struct InlineStorage
+{
+    constexpr InlineStorage() noexcept
+    {
+        // Constant evaluation can't leave the unused tail uninitialized
+        if consteval
+        {
+            for (UInt64 i = 0; i < N; i++) data[i] = T();
+        }
+    }
+
+    T data[N];
+};
+
+template <typename T, UInt64 N>
+struct InlineStorage<T, N, false>
+{
+    constexpr InlineStorage() noexcept {}
+    constexpr ~InlineStorage() noexcept {}
+
+    union
+    {
+        T data[N];
+    };
+};
+
+// Vector like container over inline storage for at most N elements, never allocates
+template <typename T, UInt64 N>
+class StaticArray
+{
+private:
+    using SizeType = UInt64;
+
+public:
+    static_assert(N > 0, "StaticArray needs a capacity");
+
+    using value_type     = T;
+    using iterator       = T*;
+    using const_iterator = const T*;
+
+    constexpr StaticArray() noexcept = default;
+
+    constexpr StaticArray(std::initializer_list<T> init)
+    {
+        TEZ_HARD_ASSERT(init.size() <= N, "Too many elements for StaticArray!");
+        for (const T& value : init) std::construct_at(Data() + _size++, value);
+    }
+
+    constexpr StaticArray(const StaticArray& other)
+    {
+        for (const T& value : other) std::construct_at(Data() + _size++, value);
+    }
+
+    constexpr StaticArray(StaticArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        for (T& value : other) std::construct_at(Data() + _size++, std::move(value));
+        other.Clear();
+    }
+
+    constexpr StaticArray& operator=(const StaticArray& other)
+    {
+        if (this == &other) return *this;
+
+        Clear();
+        for (const T& value : other) std::construct_at(Data() + _size++, value);
+        return *this;
+    }
+
+    constexpr StaticArray& operator=(StaticArray&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this == &other) return *this;
+
+        Clear();
+        for (T& value : other) std::construct_at(Data() + _size++, std::move(value));
+        other.Clear();
+        return *this;
+    }
+
+    constexpr ~StaticArray()
+        requires std::is_trivially_destructible_v<T>
+    = default;
+
+    constexpr ~StaticArray() { Clear(); }
+
+    constexpr void PushBack(const T& value) { EmplaceBack(value); }
+
+    constexpr void PushBack(T&& value) { EmplaceBack(std::move(value)); }
+
+    // Logs and drops the element when full
+    template <typename... Args>
+    constexpr void EmplaceBack(Args&&... args)
+    {
+        TEZ_SOFT_ASSERT(_size < N, "StaticArray is full!");
+        std::construct_at(Data() + _size, std::forward<Args>(args)...);
+        _size++;
+    }
+
+    template <typename... Args>
+    constexpr iterator Emplace(const_iterator pos, Args&&... args)
+    {
+        const SizeType index = static_cast<SizeType>(pos - Begin());
+        TEZ_SOFT_ASSERT(_size < N, "StaticArray is full!", End());
+
+        std::construct_at(Data() + _size, std::forward<Args>(args)...);
+        _size++;
+        std::rotate(Begin() + index, End() - 1, End());
+        return Begin() + index;
+    }
+
+    [[nodiscard]]
+    constexpr Optional<T> PopBack() noexcept
+    {
+        if (IsEmpty()) return std::nullopt;
+
+        T value = std::move(Back());
+        std::destroy_at(Data() + --_size);
+
+        if constexpr (std::is_pointer_v<T>)
+        {
+            if (!value) return std::nullopt;
+        }
+        return value;
+    }
+
+    constexpr void Clear() noexcept
+    {
+        std::destroy(Begin(), End());
+        _size = 0;
+    }
+
+    [[nodiscard]]
+    constexpr SizeType Size() const noexcept
+    {
+        return _size;
+    }
+
+    [[nodiscard]]
+    static constexpr SizeType Capacity() noexcept
+    {
+        return N;
+    }
+
+    [[nodiscard]]
+    constexpr bool IsEmpty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    [[nodiscard]]
+    constexpr bool IsFull() const noexcept
+    {
+        return _size == N;
+    }
+
+    [[nodiscard]] constexpr T& operator[](SizeType index) noexcept
+    {
+        TEZ_HARD_ASSERT(index < _size, "Index Out of Bounds!");
+        return Data()[index];
+    }
+
+    [[nodiscard]] constexpr const T& operator[](SizeType index) const noexcept
+    {
+        TEZ_HARD_ASSERT(index < _size, "Index Out of Bounds!");
+        return Data()[index];
+    }
+
+    [[nodiscard]] constexpr T& Front() noexcept { return Data()[0]; }
+    [[nodiscard]] constexpr const T& Front() const noexcept { return Data()[0]; }
+    [[nodiscard]] constexpr T& Back() noexcept { return Data()[_size - 1]; }
+    [[nodiscard]] constexpr const T& Back() const noexcept { return Data()[_size - 1]; }
+
+    [[nodiscard]] constexpr T* Data() noexcept { return _storage.data; }
+    [[nodiscard]] constexpr const T* Data() const noexcept { return _storage.data; }
+
+    [[nodiscard]] constexpr iterator Begin() noexcept { return Data(); }
+    [[nodiscard]] constexpr const_iterator Begin() const noexcept { return Data(); }
+    [[nodiscard]] constexpr iterator End() noexcept { return Data() + _size; }
+    [[nodiscard]] constexpr const_iterator End() const noexcept { return Data() + _size; }
+
+    [[nodiscard]] constexpr iterator begin() noexcept { return Begin(); }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return Begin(); }
+    [[nodiscard]] constexpr iterator end() noexcept { return End(); }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return End(); }
+
+private:
+    InlineStorage<T, N> _storage;
+    SizeType _size{0};
+};
+
+// Vector like container keeping up to N elements inline, only allocates once it grows past N
+template <typename T, UInt64 N, typename Allocator = std::allocator<T>>
+class SmallArray
+{
+private:
+    using SizeType    = UInt64;
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    static_assert(N > 0, "SmallArray needs an inline capacity");
+
+    using value_type     = T;
+    using allocator_type = Allocator;
+    using iterator       = T*;
+    using const_iterator = const T*;
+
+    constexpr SmallArray() noexcept(noexcept(Allocator()))
+        requires std::default_initializable<Allocator>
+    = default;
+
+    constexpr explicit SmallArray(const Allocator& alloc) noexcept
+        : _allocator{alloc}
+    {
+    }
+
+    constexpr SmallArray(std::initializer_list<T> init, const Allocator& alloc = Allocator{})
+        : _allocator{alloc}
+    {
+        Reserve(init.size());
+        for (const T& value : init) std::construct_at(_data + _size++, value);
+    }
+
+    constexpr SmallArray(const SmallArray& other)
+        : _allocator{AllocTraits::select_on_container_copy_construction(other._allocator)}
+    {
+        Reserve(other._size);
+        for (const T& value : other) std::construct_at(_data + _size++, value);
+    }
+
+    constexpr SmallArray(SmallArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : _allocator{std::move(other._allocator)}
+    {
+        MoveFrom(other);
+    }
+
+    constexpr SmallArray& operator=(const SmallArray& other)
+    {
+        if (this == &other) return *this;
+
+        Clear();
+        Reserve(other._size);
+        for (const T& value : other) std::construct_at(_data + _size++, value);
+        return *this;
+    }
+
+    constexpr SmallArray& operator=(SmallArray&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this == &other) return *this;
+
+        Clear();
+        if (other.IsInline() || _allocator == other._allocator)
+        {
+            Release();
+            MoveFrom(other);
+            return *this;
+        }
+
+        // Heap memory of another allocator can't be adopted
+        Reserve(other._size);
+        for (T& value : other) std::construct_at(_data + _size++, std::move(value));
+        other.Clear();
+        return *this;
+    }
+
+    constexpr ~SmallArray()
+    {
+        Clear();
+        Release();
+    }
+
+    [[nodiscard]]
+    constexpr const Allocator& GetAllocator() const noexcept
+    {
+        return _allocator;
+    }
+
+    constexpr void PushBack(const T& value) { EmplaceBack(value); }
+
+    constexpr void PushBack(T&& value) { EmplaceBack(std::move(value)); }
+
+    template <typename... Args>
+    constexpr void EmplaceBack(Args&&... args)
+    {
+        if (_size == _capacity)
+        {
+            // The arguments may live in the current buffer, construct before moving the rest
+            T* data = AllocTraits::allocate(_allocator, _capacity * 2);
+            try
+            {
+                std::construct_at(data + _size, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                AllocTraits::deallocate(_allocator, data, _capacity * 2);
+                throw;
+            }
+            Relocate(data, _capacity * 2);
+        }
+        else
+        {
+            std::construct_at(_data + _size, std::forward<Args>(args)...);
+        }
+        _size++;
+    }
+
+    template <typename... Args>
+    constexpr iterator Emplace(const_iterator pos, Args&&... args)
+    {
+        const SizeType index = static_cast<SizeType>(pos - Begin());
+        EmplaceBack(std::forward<Args>(args)...);
+        std::rotate(Begin() + index, End() - 1, End());
+        return Begin() + index;
+    }
+
+    [[nodiscard]]
+    constexpr Optional<T> PopBack() noexcept
+    {
+        if (IsEmpty()) return std::nullopt;
+
+        T value = std::move(Back());
+        std::destroy_at(_data + --_size);
+
+        if constexpr (std::is_pointer_v<T>)
+        {
+            if (!value) return std::nullopt;
+        }
+        return value;
+    }
+
+    constexpr void Clear() noexcept
+    {
+        std::destroy(Begin(), End());
+        _size = 0;
+    }
+
+    constexpr void Reserve(SizeType capacity)
+    {
+        if (capacity <= _capacity) return;
+        Relocate(AllocTraits::allocate(_allocator, capacity), capacity);
+    }
+
+    [[nodiscard]]
+    constexpr SizeType Size() const noexcept
+    {
+        return _size;
+    }
+
+    [[nodiscard]]
+    constexpr SizeType Capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    [[nodiscard]]
+    constexpr bool IsEmpty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // False once the elements spilled to the heap
+    [[nodiscard]]
+    constexpr bool IsInline() const noexcept
+    {
+        return _data == _storage.data;
+    }
+
+    [[nodiscard]] constexpr T& operator[](SizeType index) noexcept
+    {
+        TEZ_HARD_ASSERT(index < _size, "Index Out of Bounds!");
+        return _data[index];
+    }
+
+    [[nodiscard]] constexpr const T& operator[](SizeType index) const noexcept
+    {
+        TEZ_HARD_ASSERT(index < _size, "Index Out of Bounds!");
+        return _data[index];
+    }
+
+    [[nodiscard]] constexpr T& Front() noexcept { return _data[0]; }
+    [[nodiscard]] constexpr const T& Front() const noexcept { return _data[0]; }
+    [[nodiscard]] constexpr T& Back() noexcept { return _data[_size - 1]; }
+    [[nodiscard]] constexpr const T& Back() const noexcept { return _data[_size - 1]; }
+
+    [[nodiscard]] constexpr T* Data() noexcept { return _data; }
+    [[nodiscard]] constexpr const T* Data() const noexcept { return _data; }
+
+    [[nodiscard]] constexpr iterator Begin() noexcept { return _data; }
+    [[nodiscard]] constexpr const_iterator Begin() const noexcept { return _data; }
+    [[nodiscard]] constexpr iterator End() noexcept { return _data + _size; }
+    [[nodiscard]] constexpr const_iterator End() const noexcept { return _data + _size; }
+
+    [[nodiscard]] constexpr iterator begin() noexcept { return Begin(); }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return Begin(); }
+    [[nodiscard]] constexpr iterator end() noexcept { return End(); }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return End(); }
+
+private:
+    // Moves the elements into data, which must come from _allocator
+    constexpr void Relocate(T* data, SizeType capacity)
+    {
+        for (SizeType i = 0; i < _size; i++)
+        {
+            std::construct_at(data + i, std::move(_data[i]));
+            std::destroy_at(_data + i);
+        }
+
+        Release();
+        _data     = data;
+        _capacity = capacity;
+    }
+
+    constexpr void Release() noexcept
+    {
+        if (!IsInline()) AllocTraits::deallocate(_allocator, _data, _capacity);
+        _data     = _storage.data;
+        _capacity = N;
+    }
+
+    // Expects this to be empty and inline
+    constexpr void MoveFrom(SmallArray& other)
+    {
+        if (other.IsInline())
+        {
+            for (T& value : other) std::construct_at(_data + _size++, std::move(value));
+            other.Clear();
+            return;
+        }
+
+        _data     = std::exchange(other._data, other._storage.data);
+        _size     = std::exchange(other._size, 0);
+        _capacity = std::exchange(other._capacity, N);
+    }
+
+    InlineStorage<T, N> _storage;
+    T* _data{_storage.data};
+    SizeType _size{0};
+    SizeType _capacity{N};
+    [[no_unique_address]] Allocator _allocator{};
+};
 } // namespace Tez
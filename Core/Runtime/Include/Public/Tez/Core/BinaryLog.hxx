@@ -0,0 +1,325 @@
+#pragma once
+
+#include "Clock.hxx"
+#include "Log.hxx"
+#include "LogType.hxx"
+#include "Types.hxx"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Deferred formatting: only a format ID and the raw argument bytes are recorded, the text is
+// rebuilt offline by Scripts/DecodeBinaryLog.py. The format string is checked at compile time.
+// Channels other than the BinaryLogChannel still receive the formatted message, so the
+// formatting cost is only saved while the BinaryLogChannel is the sole channel.
+#define TEZ_LOGF_IMPL(logType, format, ...)                                                   \
+    do                                                                                        \
+    {                                                                                         \
+        static constinit Tez::LogFormatSite tezLogFormatSite{logType, __FILE__, __LINE__};    \
+        Tez::LogSystem::GetInstance().LogDeferred(tezLogFormatSite,                           \
+                                                  format __VA_OPT__(, ) __VA_ARGS__);         \
+    } while (0)
+
+#if TEZ_LOG_LEVEL <= 1
+    #define TEZ_LOGF_INFO(format, ...) \
+        TEZ_LOGF_IMPL(Tez::LogType::INFO, format __VA_OPT__(, ) __VA_ARGS__)
+#else
+    #define TEZ_LOGF_INFO(format, ...) ((void)0)
+#endif
+
+#if TEZ_LOG_LEVEL <= 2
+    #define TEZ_LOGF_WARNING(format, ...) \
+        TEZ_LOGF_IMPL(Tez::LogType::WARNING, format __VA_OPT__(, ) __VA_ARGS__)
+#else
+    #define TEZ_LOGF_WARNING(format, ...) ((void)0)
+#endif
+
+#if TEZ_LOG_LEVEL <= 3
+    #define TEZ_LOGF_ERROR(format, ...) \
+        TEZ_LOGF_IMPL(Tez::LogType::ERROR, format __VA_OPT__(, ) __VA_ARGS__)
+#else
+    #define TEZ_LOGF_ERROR(format, ...) ((void)0)
+#endif
+
+namespace Tez
+{
+// Encoding of a deferred argument, mirrored by Scripts/DecodeBinaryLog.py
+enum class LogArgType : UInt8
+{
+    INT64   = 0,
+    UINT64  = 1,
+    FLOAT32 = 2,
+    FLOAT64 = 3,
+    BOOL    = 4,
+    CHAR    = 5,
+    STRING  = 6,
+    POINTER = 7
+};
+
+// One per TEZ_LOGF_* call site, IDs are handed out on first use
+struct LogFormatSite
+{
+    constexpr LogFormatSite(LogType logType, const Char* file, UInt32 line)
+        : logType{logType}
+        , file{file}
+        , line{line}
+    {
+    }
+
+    std::atomic<UInt32> id{0};
+    LogType logType{LogType::INFO};
+    const Char* file{nullptr};
+    UInt32 line{0};
+    std::string_view format{};
+    const LogArgType* argTypes{nullptr};
+    UInt32 argCount{0};
+};
+
+// Registers the site under the next free ID, thread safe and idempotent
+UInt32 RegisterLogFormat(LogFormatSite& site, std::string_view format, const LogArgType* argTypes,
+                         UInt32 argCount);
+
+template <typename T>
+consteval LogArgType LogArgTypeOf()
+{
+    using U = std::remove_cvref_t<T>;
+
+    if constexpr (std::is_same_v<U, bool>)
+        return LogArgType::BOOL;
+    else if constexpr (std::is_same_v<U, char>)
+        return LogArgType::CHAR;
+    else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+        return LogArgType::INT64;
+    else if constexpr (std::is_integral_v<U>)
+        return LogArgType::UINT64;
+    else if constexpr (std::is_floating_point_v<U> && sizeof(U) == 4)
+        return LogArgType::FLOAT32;
+    else if constexpr (std::is_floating_point_v<U> && sizeof(U) == 8)
+        return LogArgType::FLOAT64;
+    else if constexpr (std::is_convertible_v<const U&, std::string_view>)
+        return LogArgType::STRING;
+    else if constexpr (std::is_pointer_v<U>)
+        return LogArgType::POINTER;
+    else
+        static_assert(false, "Type cannot be deferred, format it and use TEZ_LOG_* instead");
+}
+
+template <typename... Args>
+inline constexpr LogArgType LogArgTypes[sizeof...(Args) + 1] = {LogArgTypeOf<Args>()...,
+                                                                  LogArgType::INT64};
+
+template <typename T>
+std::string_view LogArgString(const T& arg)
+{
+    if constexpr (std::is_pointer_v<T>)
+        return arg ? std::string_view(arg) : std::string_view();
+    else
+        return std::string_view(arg);
+}
+
+template <typename T>
+UInt32 LogArgSize(const T& arg)
+{
+    constexpr LogArgType type = LogArgTypeOf<T>();
+    if constexpr (type == LogArgType::BOOL || type == LogArgType::CHAR)
+        return 1;
+    else if constexpr (type == LogArgType::FLOAT32)
+        return 4;
+    else if constexpr (type == LogArgType::STRING)
+        return sizeof(UInt16) + static_cast<UInt32>(std::min<std::size_t>(
+                                    LogArgString(arg).size(), Limits<UInt16>::max));
+    else
+        return 8;
+}
+
+template <typename T>
+Byte* EncodeLogArg(Byte* out, const T& arg)
+{
+    constexpr LogArgType type = LogArgTypeOf<T>();
+
+    const auto write = [&out]<typename V>(V value)
+    {
+        std::memcpy(out, &value, sizeof(V));
+        out += sizeof(V);
+    };
+
+    if constexpr (type == LogArgType::BOOL || type == LogArgType::CHAR)
+        write(static_cast<UInt8>(arg));
+    else if constexpr (type == LogArgType::INT64)
+        write(static_cast<Int64>(arg));
+    else if constexpr (type == LogArgType::UINT64)
+        write(static_cast<UInt64>(arg));
+    else if constexpr (type == LogArgType::FLOAT32)
+        write(static_cast<float>(arg));
+    else if constexpr (type == LogArgType::FLOAT64)
+        write(static_cast<double>(arg));
+    else if constexpr (type == LogArgType::POINTER)
+        write(reinterpret_cast<UInt64>(arg));
+    else
+    {
+        const std::string_view str = LogArgString(arg);
+        const UInt16 length =
+            static_cast<UInt16>(std::min<std::size_t>(str.size(), Limits<UInt16>::max));
+        write(length);
+        std::memcpy(out, str.data(), length);
+        out += length;
+    }
+    return out;
+}
+
+// Appends records to a chunked, memory mapped file. Every thread owns a chunk and bump
+// allocates records from it, so a write is a size computation plus a few memcpys.
+//
+// File layout (little endian):
+//   header    : "TEZBLOG\0", UInt32 version, UInt32 chunk size, ClockCalibration start,
+//               ClockCalibration latest, Int64 system clock ns at the start calibration,
+//               padded to FileHeaderSize
+//   chunks    : records back to back, a record with format ID 0 ends the chunk
+//   record    : UInt32 format ID, UInt32 payload size, UInt64 timestamp, payload
+//   timestamp : cycle counter ticks with TickTimestampBit set, else ns since epoch
+//
+// Every record this channel writes is stamped with ticks, text records included, so records
+// from Log() and TEZ_LOGF_* sort on the same clock.
+//   payload   : encoded arguments, or a format definition when the ID is DefinitionRecordID
+//
+// The channel must outlive every thread logging through it.
+class BinaryLogChannel : public ILogChannel
+{
+public:
+    static constexpr UInt32 FileVersion        = 2;
+    static constexpr UInt32 FileHeaderSize     = 4096;
+    static constexpr UInt32 RecordHeaderSize   = 16;
+    static constexpr UInt32 DefinitionRecordID = 0xFFFFFFFF;
+    static constexpr UInt32 DefaultChunkSize   = 1 << 20;
+    static constexpr UInt64 TickTimestampBit   = 1ULL << 63;
+
+    // chunkSize is rounded up to a multiple of FileHeaderSize
+    explicit BinaryLogChannel(std::string path, UInt32 chunkSize = DefaultChunkSize);
+    ~BinaryLogChannel() override;
+
+    BinaryLogChannel(const BinaryLogChannel&)            = delete;
+    BinaryLogChannel& operator=(const BinaryLogChannel&) = delete;
+
+    // Already formatted entries are stored as a "{}" record of their level
+    void OnLogReceived(const LogEntry& log) override;
+
+    template <typename... Args>
+    void Write(LogFormatSite& site, std::string_view format, const Args&... args);
+
+    // Pushes the mapped chunks to the file
+    void Flush();
+
+    [[nodiscard]] bool IsOpen() const noexcept { return _file != nullptr; }
+
+    [[nodiscard]] UInt64 GetDroppedCount() const noexcept
+    {
+        return _droppedCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct ThreadChunk
+    {
+        UInt64 generation{0};
+        Byte* base{nullptr};
+        Byte* cursor{nullptr};
+        Byte* end{nullptr};
+    };
+
+    struct Chunk
+    {
+        UInt64 index{0};
+        Byte* base{nullptr};
+    };
+
+    template <typename... Args>
+    void WriteRecord(LogFormatSite& site, UInt64 timestamp, const Args&... args);
+
+    Byte* Reserve(UInt32 size)
+    {
+        ThreadChunk& chunk = _threadChunk;
+        if (chunk.generation == _generation &&
+            static_cast<UInt64>(chunk.end - chunk.cursor) >= size) [[likely]]
+        {
+            Byte* record = chunk.cursor;
+            chunk.cursor += size;
+            return record;
+        }
+        return ReserveSlow(size);
+    }
+
+    Byte* ReserveSlow(UInt32 size);
+    void WriteDefinitions(UInt32 upToID);
+    bool MapChunk(Chunk& chunk);
+    void UnmapChunk(Chunk& chunk);
+    void RetireChunk(Byte* base);
+    void WriteCalibration();
+
+    static thread_local ThreadChunk _threadChunk;
+
+    std::string _path{};
+    std::FILE* _file{nullptr};
+    ClockCalibration _startCalibration{};
+    UInt32 _chunkSize{DefaultChunkSize};
+    UInt64 _generation{0};
+    UInt64 _chunkCount{0};
+    UInt64 _fileSize{0};
+    std::vector<Chunk> _chunks{};
+    std::mutex _mutex{};
+    std::mutex _definitionMutex{};
+    std::atomic<UInt32> _definedCount{0};
+    std::atomic<UInt64> _droppedCount{0};
+};
+
+inline thread_local BinaryLogChannel::ThreadChunk BinaryLogChannel::_threadChunk{};
+
+template <typename... Args>
+void BinaryLogChannel::Write(LogFormatSite& site, std::string_view format, const Args&... args)
+{
+    if (site.id.load(std::memory_order_acquire) == 0) [[unlikely]]
+        RegisterLogFormat(site, format, LogArgTypes<Args...>, sizeof...(Args));
+
+    WriteRecord(site, ReadCycleCounter() | TickTimestampBit, args...);
+}
+
+template <typename... Args>
+void BinaryLogChannel::WriteRecord(LogFormatSite& site, UInt64 timestamp, const Args&... args)
+{
+    if (!IsOpen()) return;
+
+    const UInt32 id = site.id.load(std::memory_order_acquire);
+    if (id > _definedCount.load(std::memory_order_acquire)) [[unlikely]]
+        WriteDefinitions(id);
+
+    const UInt32 payloadSize = (0 + ... + LogArgSize(args));
+    Byte* out                = Reserve(RecordHeaderSize + payloadSize);
+    if (!out) return;
+
+    std::memcpy(out, &id, sizeof(UInt32));
+    std::memcpy(out + 4, &payloadSize, sizeof(UInt32));
+    std::memcpy(out + 8, &timestamp, sizeof(UInt64));
+    out += RecordHeaderSize;
+    ((out = EncodeLogArg(out, args)), ...);
+}
+
+template <typename... Args>
+void LogSystem::LogDeferred(LogFormatSite& site, std::format_string<Args...> format, Args&&... args)
+{
+    if (!_binaryChannel)
+    {
+        Log(std::format(format, std::forward<Args>(args)...), site.logType);
+        return;
+    }
+
+    _binaryChannel->Write(site, format.get(), args...);
+    if (_logChannels.Size() > 1)
+        LogExcept(std::format(format, std::forward<Args>(args)...), site.logType, _binaryChannel);
+}
+} // namespace Tez
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Types.hxx"
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define TEZ_HAS_CYCLE_COUNTER
+#endif
+
+namespace Tez
+{
+// Cheapest monotonic tick source available, ticks only mean something once calibrated against
+// a real clock (see ClockCalibration)
+[[nodiscard]] inline UInt64 ReadCycleCounter() noexcept
+{
+#if defined(TEZ_HAS_CYCLE_COUNTER)
+    return __rdtsc();
+#else
+    return static_cast<UInt64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// A cycle counter reading paired with the steady clock, two of them give the tick rate. The
+// system clock can be stepped between two readings, so it is never part of a calibration.
+struct ClockCalibration
+{
+    UInt64 ticks{0};
+    Int64 nanoseconds{0};
+
+    [[nodiscard]] static ClockCalibration Now() noexcept
+    {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return ClockCalibration{
+            .ticks       = ReadCycleCounter(),
+            .nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()};
+    }
+};
+
+// Nanoseconds since the system clock epoch, read once next to a ClockCalibration to place the
+// calibrated ticks in wall time
+[[nodiscard]] inline Int64 ReadWallClock() noexcept
+{
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+} // namespace Tez
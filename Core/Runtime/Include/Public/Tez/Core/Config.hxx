@@ -39,5 +39,10 @@
     #error "Unknown Compiler! Could not resolve TEZ_FUNC_SIG"
 #endif
 
+// Lowest Tez::LogType whose TEZ_LOG_* / TEZ_LOGF_* macros are compiled in, 0 keeps everything
+#ifndef TEZ_LOG_LEVEL
+    #define TEZ_LOG_LEVEL 0
+#endif
+
 // TODO: remove this hard define
 #define TEZ_ENABLE_IMGUI
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "LinearAllocator.hxx"
+#include "Memory.hxx"
+#include "Types.hxx"
+#include <algorithm>
+#include <memory_resource>
+
+namespace Tez
+{
+// Two linear allocators used in turns, one per frame. Memory allocated during a frame stays
+// valid through the next one, so it can be handed from the game to the render frame.
+// Not thread safe.
+class FrameAllocator : public std::pmr::memory_resource
+{
+public:
+    explicit FrameAllocator(UInt64 capacityPerFrame,
+                            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    FrameAllocator(const FrameAllocator&)            = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    ~FrameAllocator() override = default;
+
+    [[nodiscard]]
+    void* Allocate(UInt64 bytes, UInt64 alignment = alignof(std::max_align_t)) noexcept
+    {
+        void* ptr = _frames[_current].Allocate(bytes, alignment);
+
+        // Tracked here, a frame can free allocations before it ends
+        const UInt64 bytesInUse = _frames[0].GetBytesInUse() + _frames[1].GetBytesInUse();
+        _peakBytesInUse         = std::max(_peakBytesInUse, bytesInUse);
+        return ptr;
+    }
+
+    // Only updates the stats, the memory waits for the frame's reset
+    void Deallocate(void* ptr, UInt64 bytes, UInt64 alignment = alignof(std::max_align_t)) noexcept
+    {
+        LinearAllocator& frame = _frames[_current];
+        if (frame.Owns(ptr))
+            frame.Deallocate(ptr, bytes, alignment);
+        else if (_frames[_current ^ 1].Owns(ptr))
+            _frames[_current ^ 1].Deallocate(ptr, bytes, alignment);
+    }
+
+    // Switches to the other buffer and resets it, freeing what was allocated two frames ago
+    void NextFrame() noexcept;
+
+    // Stats of both buffers combined
+    [[nodiscard]] AllocatorStats GetStats() const noexcept;
+
+    [[nodiscard]] LinearAllocator& GetCurrentFrame() noexcept { return _frames[_current]; }
+    [[nodiscard]] LinearAllocator& GetPreviousFrame() noexcept { return _frames[_current ^ 1]; }
+    [[nodiscard]] UInt64 GetFrameIndex() const noexcept { return _frameIndex; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    LinearAllocator _frames[2];
+    UInt32 _current{0};
+    UInt64 _frameIndex{0};
+    UInt64 _peakBytesInUse{0};
+};
+} // namespace Tez
@@ -0,0 +1,652 @@
+#pragma once
+
+#include "Types.hxx"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define TEZ_HASH_GROUP_SSE2
+#endif
+
+namespace Tez
+{
+// std::hash followed by a 64 bit finalizer, the tables below take their probe position and
+// control byte from different bits so all of them need to depend on the key
+template <typename T>
+struct Hash
+{
+    [[nodiscard]] UInt64 operator()(const T& value) const noexcept
+    {
+        UInt64 hash = static_cast<UInt64>(std::hash<T>{}(value));
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccd;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53;
+        hash ^= hash >> 33;
+        return hash;
+    }
+};
+
+// For keys that already are well mixed hashes, e.g. TypeID<T>()
+struct IdentityHash
+{
+    template <typename T>
+    [[nodiscard]] constexpr UInt64 operator()(const T& value) const noexcept
+    {
+        return static_cast<UInt64>(value);
+    }
+};
+
+// One control byte per slot, full slots hold the low 7 bits of their hash
+struct HashControl
+{
+    static constexpr Int8 EMPTY   = -128;
+    static constexpr Int8 DELETED = -2;
+};
+
+// Matches a window of control bytes at once, bit i of a result stands for byte i
+class HashGroup
+{
+public:
+    static constexpr UInt64 Width = 16;
+
+#if defined(TEZ_HASH_GROUP_SSE2)
+    explicit HashGroup(const Int8* control) noexcept
+        : _control{_mm_loadu_si128(reinterpret_cast<const __m128i*>(control))}
+    {
+    }
+
+    [[nodiscard]] UInt32 Match(Int8 h2) const noexcept
+    {
+        return static_cast<UInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _control)));
+    }
+
+    [[nodiscard]] UInt32 MatchEmpty() const noexcept { return Match(HashControl::EMPTY); }
+
+    [[nodiscard]] UInt32 MatchEmptyOrDeleted() const noexcept
+    {
+        // Both are below -1, full slots are not
+        return static_cast<UInt32>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), _control)));
+    }
+
+    [[nodiscard]] UInt32 MatchFull() const noexcept
+    {
+        return ~static_cast<UInt32>(_mm_movemask_epi8(_control)) & 0xFFFF;
+    }
+
+private:
+    __m128i _control;
+#else
+    explicit HashGroup(const Int8* control) noexcept { std::memcpy(_control, control, Width); }
+
+    [[nodiscard]] UInt32 Match(Int8 h2) const noexcept
+    {
+        UInt32 mask = 0;
+        for (UInt32 i = 0; i < Width; i++) mask |= static_cast<UInt32>(_control[i] == h2) << i;
+        return mask;
+    }
+
+    [[nodiscard]] UInt32 MatchEmpty() const noexcept { return Match(HashControl::EMPTY); }
+
+    [[nodiscard]] UInt32 MatchEmptyOrDeleted() const noexcept
+    {
+        UInt32 mask = 0;
+        for (UInt32 i = 0; i < Width; i++) mask |= static_cast<UInt32>(_control[i] < -1) << i;
+        return mask;
+    }
+
+    [[nodiscard]] UInt32 MatchFull() const noexcept
+    {
+        UInt32 mask = 0;
+        for (UInt32 i = 0; i < Width; i++) mask |= static_cast<UInt32>(_control[i] >= 0) << i;
+        return mask;
+    }
+
+private:
+    Int8 _control[Width];
+#endif
+};
+
+// Open addressing table (Swiss table layout): slots sit in one flat array next to a control
+// byte array probed a HashGroup at a time. Insertions may move slots, invalidating pointers.
+template <typename Slot, typename Key, typename KeyOf, typename Hasher, typename KeyEqual,
+          typename Allocator>
+class FlatHashTable
+{
+private:
+    using SizeType         = UInt64;
+    using SlotAllocator    = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using ControlAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Int8>;
+
+    static constexpr UInt64 Width = HashGroup::Width;
+
+public:
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Slot;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const Slot*, Slot*>;
+        using reference         = std::conditional_t<Const, const Slot&, Slot&>;
+
+        Iterator() = default;
+
+        operator Iterator<true>() const noexcept
+            requires(!Const)
+        {
+            return Iterator<true>(_window, _windowSlot, _slot, _end, _full);
+        }
+
+        [[nodiscard]] reference operator*() const noexcept { return *_slot; }
+        [[nodiscard]] pointer operator->() const noexcept { return _slot; }
+
+        Iterator& operator++() noexcept
+        {
+            // Iterators from Find haven't looked at the rest of their window yet
+            if (_full == Unscanned) [[unlikely]]
+            {
+                const UInt64 offset = static_cast<UInt64>(_slot - _windowSlot);
+                _full               = HashGroup(_window).MatchFull() & ~((2u << offset) - 1);
+            }
+            Advance();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        [[nodiscard]] friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs._slot == rhs._slot;
+        }
+
+    private:
+        friend class FlatHashTable;
+        friend class Iterator<!Const>;
+
+        // Above any MatchFull result
+        static constexpr UInt32 Unscanned = ~0u;
+
+        Iterator(const Int8* window, pointer windowSlot, pointer slot, const Int8* end,
+                 UInt32 full) noexcept
+            : _window{window}
+            , _windowSlot{windowSlot}
+            , _slot{slot}
+            , _end{end}
+            , _full{full}
+        {
+        }
+
+        // Moves to the lowest slot left in _full, or to the first full slot of a later window.
+        // Capacities are multiples of Width, so the windows tile the table.
+        void Advance() noexcept
+        {
+            while (!_full)
+            {
+                _window += Width;
+                _windowSlot += Width;
+                if (_window >= _end)
+                {
+                    _slot = _windowSlot;
+                    return;
+                }
+                _full = HashGroup(_window).MatchFull();
+            }
+
+            _slot = _windowSlot + std::countr_zero(_full);
+            _full &= _full - 1;
+        }
+
+        const Int8* _window{nullptr};
+        pointer _windowSlot{nullptr};
+        pointer _slot{nullptr};
+        const Int8* _end{nullptr};
+        // Full slots of the window after _slot
+        UInt32 _full{0};
+    };
+
+    using value_type     = Slot;
+    using allocator_type = Allocator;
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashTable() = default;
+
+    explicit FlatHashTable(const Allocator& alloc)
+        : _allocator{alloc}
+    {
+    }
+
+    FlatHashTable(const FlatHashTable& other)
+        : _hasher{other._hasher}
+        , _keyEqual{other._keyEqual}
+        , _allocator{std::allocator_traits<SlotAllocator>::select_on_container_copy_construction(
+              other._allocator)}
+    {
+        Reserve(other._size);
+        for (const Slot& slot : other) EmplaceKey(KeyOf{}(slot), slot);
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+        : _control{std::exchange(other._control, nullptr)}
+        , _slots{std::exchange(other._slots, nullptr)}
+        , _capacity{std::exchange(other._capacity, 0)}
+        , _size{std::exchange(other._size, 0)}
+        , _growthLeft{std::exchange(other._growthLeft, 0)}
+        , _hasher{std::move(other._hasher)}
+        , _keyEqual{std::move(other._keyEqual)}
+        , _allocator{std::move(other._allocator)}
+    {
+    }
+
+    FlatHashTable& operator=(const FlatHashTable& other)
+    {
+        if (this != &other) *this = FlatHashTable(other);
+        return *this;
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        std::swap(_control, other._control);
+        std::swap(_slots, other._slots);
+        std::swap(_capacity, other._capacity);
+        std::swap(_size, other._size);
+        std::swap(_growthLeft, other._growthLeft);
+        std::swap(_hasher, other._hasher);
+        std::swap(_keyEqual, other._keyEqual);
+        std::swap(_allocator, other._allocator);
+        return *this;
+    }
+
+    ~FlatHashTable()
+    {
+        DestroySlots();
+        Deallocate(_control, _slots, _capacity);
+    }
+
+    [[nodiscard]] iterator Find(const Key& key) noexcept
+    {
+        const UInt64 index = FindIndex(key);
+        return index == _capacity ? End() : MakeIterator(index);
+    }
+
+    [[nodiscard]] const_iterator Find(const Key& key) const noexcept
+    {
+        const UInt64 index = FindIndex(key);
+        return index == _capacity ? End() : MakeIterator(index);
+    }
+
+    [[nodiscard]] bool Contains(const Key& key) const noexcept
+    {
+        return FindIndex(key) != _capacity;
+    }
+
+    bool Erase(const Key& key)
+    {
+        const UInt64 index = FindIndex(key);
+        if (index == _capacity) return false;
+
+        EraseIndex(index);
+        return true;
+    }
+
+    void Erase(const_iterator pos) { EraseIndex(static_cast<UInt64>(pos._slot - _slots)); }
+
+    void Clear() noexcept
+    {
+        if (_capacity == 0) return;
+
+        DestroySlots();
+        std::memset(_control, HashControl::EMPTY, _capacity + Width);
+        _size       = 0;
+        _growthLeft = MaxLoad(_capacity);
+    }
+
+    // Makes room for count entries without rehashing
+    void Reserve(SizeType count)
+    {
+        if (count <= _size + _growthLeft) return;
+
+        const UInt64 capacity = std::bit_ceil(std::max<UInt64>(count + count / 7 + 1, Width));
+        if (capacity > _capacity) Rehash(capacity);
+    }
+
+    [[nodiscard]] SizeType Size() const noexcept { return _size; }
+    [[nodiscard]] SizeType Capacity() const noexcept { return _capacity; }
+    [[nodiscard]] bool IsEmpty() const noexcept { return _size == 0; }
+
+    // The table stores its allocator rebound to the slot type
+    [[nodiscard]] Allocator GetAllocator() const noexcept { return Allocator(_allocator); }
+
+    [[nodiscard]] iterator Begin() noexcept
+    {
+        if (_capacity == 0) return End();
+
+        iterator it(_control, _slots, _slots, _control + _capacity,
+                    HashGroup(_control).MatchFull());
+        it.Advance();
+        return it;
+    }
+
+    [[nodiscard]] const_iterator Begin() const noexcept
+    {
+        if (_capacity == 0) return End();
+
+        const_iterator it(_control, _slots, _slots, _control + _capacity,
+                          HashGroup(_control).MatchFull());
+        it.Advance();
+        return it;
+    }
+
+    [[nodiscard]] iterator End() noexcept { return MakeIterator(_capacity); }
+    [[nodiscard]] const_iterator End() const noexcept { return MakeIterator(_capacity); }
+
+    [[nodiscard]] iterator begin() noexcept { return Begin(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return Begin(); }
+    [[nodiscard]] iterator end() noexcept { return End(); }
+    [[nodiscard]] const_iterator end() const noexcept { return End(); }
+
+protected:
+    // Constructs Slot(args...) if no slot holds key yet
+    template <typename... Args>
+    std::pair<iterator, bool> EmplaceKey(const Key& key, Args&&... args)
+    {
+        const UInt64 hash = _hasher(key);
+        if (const UInt64 index = FindIndex(key, hash); index != _capacity)
+            return {MakeIterator(index), false};
+
+        UInt64 index = _capacity ? FindFirstNonFull(hash) : 0;
+        if (_capacity == 0 || (_growthLeft == 0 && _control[index] == HashControl::EMPTY))
+        {
+            GrowForInsert();
+            index = FindFirstNonFull(hash);
+        }
+
+        std::construct_at(_slots + index, std::forward<Args>(args)...);
+        if (_control[index] == HashControl::EMPTY) _growthLeft--;
+        SetControl(index, H2(hash));
+        _size++;
+        return {MakeIterator(index), true};
+    }
+
+private:
+    [[nodiscard]] static constexpr UInt64 MaxLoad(UInt64 capacity) noexcept
+    {
+        // 7/8 keeps an empty slot in every probe sequence
+        return capacity - capacity / 8;
+    }
+
+    [[nodiscard]] static constexpr Int8 H2(UInt64 hash) noexcept
+    {
+        return static_cast<Int8>(hash & 0x7F);
+    }
+
+    [[nodiscard]] UInt64 FindIndex(const Key& key) const noexcept
+    {
+        if (_capacity == 0) return 0;
+        return FindIndex(key, _hasher(key));
+    }
+
+    // Returns _capacity when key is missing. Probes triangular steps of whole windows, which
+    // visits every window once for power of two capacities.
+    [[nodiscard]] UInt64 FindIndex(const Key& key, UInt64 hash) const noexcept
+    {
+        if (_capacity == 0) return 0;
+
+        const UInt64 mask = _capacity - 1;
+        const Int8 h2     = H2(hash);
+        UInt64 offset     = (hash >> 7) & mask;
+        for (UInt64 step = Width;; step += Width)
+        {
+            const HashGroup group(_control + offset);
+            for (UInt32 match = group.Match(h2); match; match &= match - 1)
+            {
+                const UInt64 index = (offset + std::countr_zero(match)) & mask;
+                if (_keyEqual(KeyOf{}(_slots[index]), key)) return index;
+            }
+
+            if (group.MatchEmpty()) return _capacity;
+            offset = (offset + step) & mask;
+        }
+    }
+
+    [[nodiscard]] UInt64 FindFirstNonFull(UInt64 hash) const noexcept
+    {
+        const UInt64 mask = _capacity - 1;
+        UInt64 offset     = (hash >> 7) & mask;
+        for (UInt64 step = Width;; step += Width)
+        {
+            if (const UInt32 free = HashGroup(_control + offset).MatchEmptyOrDeleted())
+                return (offset + std::countr_zero(free)) & mask;
+            offset = (offset + step) & mask;
+        }
+    }
+
+    // The first Width bytes are cloned past the end so windows never wrap
+    void SetControl(UInt64 index, Int8 value) noexcept
+    {
+        _control[index] = value;
+        if (index < Width) _control[_capacity + index] = value;
+    }
+
+    void EraseIndex(UInt64 index)
+    {
+        std::destroy_at(_slots + index);
+        _size--;
+
+        // A slot with an empty neighbour on both sides within one window never stopped a probe,
+        // it can go back to empty instead of leaving a tombstone
+        const UInt64 before     = (index - Width) & (_capacity - 1);
+        const UInt32 emptyAfter = HashGroup(_control + index).MatchEmpty();
+        const UInt16 emptyBefore =
+            static_cast<UInt16>(HashGroup(_control + before).MatchEmpty());
+        if (emptyAfter && emptyBefore &&
+            static_cast<UInt64>(std::countr_zero(emptyAfter) + std::countl_zero(emptyBefore)) <
+                Width)
+        {
+            SetControl(index, HashControl::EMPTY);
+            _growthLeft++;
+        }
+        else
+        {
+            SetControl(index, HashControl::DELETED);
+        }
+    }
+
+    void GrowForInsert()
+    {
+        // Mostly tombstones, rehashing in place is enough
+        if (_capacity > 0 && _size <= MaxLoad(_capacity) / 2)
+            Rehash(_capacity);
+        else
+            Rehash(_capacity ? _capacity * 2 : Width);
+    }
+
+    void Rehash(UInt64 capacity)
+    {
+        // Both arrays exist before any member changes, so a throwing allocator leaves the table
+        // as it was
+        ControlAllocator controlAllocator(_allocator);
+        Int8* control = std::allocator_traits<ControlAllocator>::allocate(controlAllocator,
+                                                                          capacity + Width);
+        Slot* slots   = nullptr;
+        try
+        {
+            slots = std::allocator_traits<SlotAllocator>::allocate(_allocator, capacity);
+        }
+        catch (...)
+        {
+            std::allocator_traits<ControlAllocator>::deallocate(controlAllocator, control,
+                                                                capacity + Width);
+            throw;
+        }
+        std::memset(control, HashControl::EMPTY, capacity + Width);
+
+        Int8* oldControl        = std::exchange(_control, control);
+        Slot* oldSlots          = std::exchange(_slots, slots);
+        const UInt64 oldCapacity = std::exchange(_capacity, capacity);
+
+        for (UInt64 i = 0; i < oldCapacity; i++)
+        {
+            if (oldControl[i] < 0) continue;
+
+            const UInt64 hash  = _hasher(KeyOf{}(oldSlots[i]));
+            const UInt64 index = FindFirstNonFull(hash);
+            std::construct_at(_slots + index, std::move(oldSlots[i]));
+            std::destroy_at(oldSlots + i);
+            SetControl(index, H2(hash));
+        }
+
+        _growthLeft = MaxLoad(_capacity) - _size;
+        Deallocate(oldControl, oldSlots, oldCapacity);
+    }
+
+    void DestroySlots() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<Slot>)
+        {
+            for (UInt64 i = 0; i < _capacity; i++)
+                if (_control[i] >= 0) std::destroy_at(_slots + i);
+        }
+    }
+
+    void Deallocate(Int8* control, Slot* slots, UInt64 capacity) noexcept
+    {
+        if (capacity == 0) return;
+
+        ControlAllocator controlAllocator(_allocator);
+        std::allocator_traits<ControlAllocator>::deallocate(controlAllocator, control,
+                                                            capacity + Width);
+        std::allocator_traits<SlotAllocator>::deallocate(_allocator, slots, capacity);
+    }
+
+    [[nodiscard]] iterator MakeIterator(UInt64 index) noexcept
+    {
+        const UInt64 window = index & ~(Width - 1);
+        return iterator(_control + window, _slots + window, _slots + index, _control + _capacity,
+                        index == _capacity ? 0 : iterator::Unscanned);
+    }
+
+    [[nodiscard]] const_iterator MakeIterator(UInt64 index) const noexcept
+    {
+        const UInt64 window = index & ~(Width - 1);
+        return const_iterator(_control + window, _slots + window, _slots + index,
+                              _control + _capacity,
+                              index == _capacity ? 0 : const_iterator::Unscanned);
+    }
+
+    Int8* _control{nullptr};
+    Slot* _slots{nullptr};
+    UInt64 _capacity{0};
+    UInt64 _size{0};
+    UInt64 _growthLeft{0};
+    [[no_unique_address]] Hasher _hasher{};
+    [[no_unique_address]] KeyEqual _keyEqual{};
+    [[no_unique_address]] SlotAllocator _allocator{};
+};
+
+struct FlatHashMapKeyOf
+{
+    template <typename Pair>
+    [[nodiscard]] constexpr const auto& operator()(const Pair& pair) const noexcept
+    {
+        return pair.first;
+    }
+};
+
+struct FlatHashSetKeyOf
+{
+    template <typename Key>
+    [[nodiscard]] constexpr const Key& operator()(const Key& key) const noexcept
+    {
+        return key;
+    }
+};
+
+// Entries are std::pair<K, V>, changing the key through an iterator breaks the table
+template <typename K, typename V, typename Hasher = Hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<std::pair<K, V>>>
+class FlatHashMap
+    : public FlatHashTable<std::pair<K, V>, K, FlatHashMapKeyOf, Hasher, KeyEqual, Allocator>
+{
+private:
+    using Base = FlatHashTable<std::pair<K, V>, K, FlatHashMapKeyOf, Hasher, KeyEqual, Allocator>;
+
+public:
+    using key_type    = K;
+    using mapped_type = V;
+    using typename Base::const_iterator;
+    using typename Base::iterator;
+
+    using Base::Base;
+
+    template <typename... Args>
+    std::pair<iterator, bool> TryEmplace(const K& key, Args&&... args)
+    {
+        return Base::EmplaceKey(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> TryEmplace(K&& key, Args&&... args)
+    {
+        return Base::EmplaceKey(key, std::piecewise_construct,
+                                std::forward_as_tuple(std::move(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    // Leaves an existing entry untouched
+    std::pair<iterator, bool> Insert(const K& key, const V& value)
+    {
+        return TryEmplace(key, value);
+    }
+
+    std::pair<iterator, bool> Insert(K&& key, V&& value)
+    {
+        return TryEmplace(std::move(key), std::move(value));
+    }
+
+    template <typename T>
+    std::pair<iterator, bool> InsertOrAssign(const K& key, T&& value)
+    {
+        auto result = TryEmplace(key, std::forward<T>(value));
+        if (!result.second) result.first->second = std::forward<T>(value);
+        return result;
+    }
+
+    V& operator[](const K& key) { return TryEmplace(key).first->second; }
+    V& operator[](K&& key) { return TryEmplace(std::move(key)).first->second; }
+};
+
+template <typename K, typename Hasher = Hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<K>>
+class FlatHashSet : public FlatHashTable<K, K, FlatHashSetKeyOf, Hasher, KeyEqual, Allocator>
+{
+private:
+    using Base = FlatHashTable<K, K, FlatHashSetKeyOf, Hasher, KeyEqual, Allocator>;
+
+public:
+    using key_type = K;
+    using typename Base::const_iterator;
+    using typename Base::iterator;
+
+    using Base::Base;
+
+    std::pair<iterator, bool> Insert(const K& key) { return Base::EmplaceKey(key, key); }
+    std::pair<iterator, bool> Insert(K&& key) { return Base::EmplaceKey(key, std::move(key)); }
+};
+} // namespace Tez
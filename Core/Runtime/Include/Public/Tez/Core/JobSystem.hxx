@@ -0,0 +1,340 @@
+#pragma once
+
+#include "Array.hxx"
+#include "Types.hxx"
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Tez
+{
+class JobSystem;
+struct Job;
+
+// Links a job into the continuation list of one of its dependencies
+struct JobEdge
+{
+    Job* job{nullptr};
+    JobEdge* next{nullptr};
+};
+
+struct alignas(64) Job
+{
+    // Callables up to this size are stored in the job itself
+    static constexpr UInt64 StorageSize = 64;
+
+    void (*invoke)(Job& job){nullptr};
+    void (*destroy)(Job& job){nullptr};
+    std::atomic<UInt32> references{0};
+    std::atomic<UInt32> pendingDependencies{0};
+    std::atomic<bool> done{false};
+    std::atomic<JobEdge*> continuations{nullptr};
+    SmallArray<JobEdge, 2> edges{};
+    alignas(std::max_align_t) Byte storage[StorageSize];
+};
+
+// Shared reference to a scheduled job, keeps it alive for IsDone and as a dependency
+class JobHandle
+{
+public:
+    JobHandle() = default;
+    JobHandle(const JobHandle& other) noexcept;
+    JobHandle(JobHandle&& other) noexcept
+        : _job{std::exchange(other._job, nullptr)}
+    {
+    }
+
+    JobHandle& operator=(const JobHandle& other) noexcept;
+    JobHandle& operator=(JobHandle&& other) noexcept;
+
+    ~JobHandle();
+
+    [[nodiscard]] bool IsValid() const noexcept { return _job != nullptr; }
+
+    // Invalid handles count as done
+    [[nodiscard]] bool IsDone() const noexcept
+    {
+        return !_job || _job->done.load(std::memory_order_acquire);
+    }
+
+private:
+    friend class JobSystem;
+
+    explicit JobHandle(Job* job) noexcept
+        : _job{job}
+    {
+    }
+
+    Job* _job{nullptr};
+};
+
+// Fixed pool of worker threads, each owning a lock-free work-stealing deque. The thread that
+// creates the system is worker 0 and only runs jobs from inside Wait.
+class JobSystem
+{
+public:
+    // ParallelFor/ParallelReduce aim for this many chunks per worker when picking a grain size
+    static constexpr UInt64 ChunksPerWorker = 4;
+
+    // workerCount includes the creating thread, 0 uses one per hardware thread
+    explicit JobSystem(UInt32 workerCount = 0);
+
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Runs whatever is still queued, then joins the workers
+    ~JobSystem();
+
+    // Created on first use, by the thread that becomes its worker 0
+    static JobSystem& GetInstance();
+
+    // func runs once every dependency is done. If it throws, the job still counts as done and the
+    // exception leaves the thread that ran it: Wait() on the caller, std::terminate on a worker.
+    template <typename Func>
+    JobHandle Schedule(Func&& func, std::span<const JobHandle> dependencies = {});
+
+    template <typename Func>
+    JobHandle Schedule(Func&& func, std::initializer_list<JobHandle> dependencies)
+    {
+        return Schedule(std::forward<Func>(func),
+                        std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+    }
+
+    template <typename Func>
+    JobHandle Then(const JobHandle& job, Func&& func)
+    {
+        return Schedule(std::forward<Func>(func), std::span<const JobHandle>(&job, 1));
+    }
+
+    // Runs pending jobs on the calling thread until job is done
+    void Wait(const JobHandle& job);
+
+    [[nodiscard]] UInt32 GetWorkerCount() const noexcept { return _workerCount; }
+
+    [[nodiscard]] UInt64 GetGrainSize(UInt64 count) const noexcept
+    {
+        return std::max<UInt64>(1, count / (static_cast<UInt64>(_workerCount) * ChunksPerWorker));
+    }
+
+private:
+    struct Worker;
+
+    static constexpr UInt32 NoWorker = Limits<UInt32>::max;
+
+    Job* AllocateJob();
+    JobHandle Submit(Job* job, std::span<const JobHandle> dependencies);
+    void Push(Job* job);
+    Job* FindJob(UInt32 workerIndex);
+    void Execute(Job* job);
+    void Finish(Job* job);
+    void WorkerLoop(UInt32 workerIndex);
+    UInt32 GetWorkerIndex() const noexcept;
+
+    UInt32 _workerCount{0};
+    std::thread::id _ownerThread{};
+    std::unique_ptr<Worker[]> _workers{};
+
+    // Jobs pushed by threads that aren't workers of this system
+    std::mutex _injectedMutex{};
+    std::vector<Job*> _injected{};
+    std::atomic<UInt64> _injectedCount{0};
+
+    std::atomic<bool> _stopping{false};
+    alignas(64) std::atomic<UInt32> _signal{0};
+    alignas(64) std::atomic<UInt32> _sleeping{0};
+};
+
+template <typename Func>
+JobHandle JobSystem::Schedule(Func&& func, std::span<const JobHandle> dependencies)
+{
+    using Callable = std::decay_t<Func>;
+    static_assert(std::is_invocable_v<Callable&>, "Jobs take no arguments");
+
+    Job* job = AllocateJob();
+    if constexpr (sizeof(Callable) <= Job::StorageSize &&
+                  alignof(Callable) <= alignof(std::max_align_t))
+    {
+        std::construct_at(reinterpret_cast<Callable*>(job->storage), std::forward<Func>(func));
+        job->invoke  = [](Job& self)
+        { (*std::launder(reinterpret_cast<Callable*>(self.storage)))(); };
+        job->destroy = [](Job& self)
+        { std::destroy_at(std::launder(reinterpret_cast<Callable*>(self.storage))); };
+    }
+    else
+    {
+        Callable* callable = new Callable(std::forward<Func>(func));
+        std::memcpy(job->storage, &callable, sizeof(callable));
+        job->invoke = [](Job& self)
+        {
+            Callable* callable = nullptr;
+            std::memcpy(&callable, self.storage, sizeof(callable));
+            (*callable)();
+        };
+        job->destroy = [](Job& self)
+        {
+            Callable* callable = nullptr;
+            std::memcpy(&callable, self.storage, sizeof(callable));
+            delete callable;
+        };
+    }
+    return Submit(job, dependencies);
+}
+
+template <typename T>
+concept IsContiguousContainer = requires(T& container) {
+    { container.Data() } -> std::convertible_to<const void*>;
+    { container.Size() } -> std::convertible_to<UInt64>;
+};
+
+// Splits [0, count) into chunks of grainSize (0 picks one from the worker count) and runs
+// func(index) or func(begin, end) over them on every worker, returns once all chunks ran
+template <typename Func>
+void ParallelFor(JobSystem& jobs, UInt64 count, Func&& func, UInt64 grainSize = 0)
+{
+    if (count == 0) return;
+    if (grainSize == 0) grainSize = jobs.GetGrainSize(count);
+
+    const UInt64 chunkCount = (count + grainSize - 1) / grainSize;
+    const auto runChunk     = [&](UInt64 chunk)
+    {
+        const UInt64 begin = chunk * grainSize;
+        const UInt64 end   = std::min(begin + grainSize, count);
+        if constexpr (std::is_invocable_v<Func&, UInt64, UInt64>)
+            func(begin, end);
+        else
+            for (UInt64 i = begin; i < end; i++) func(i);
+    };
+
+    if (chunkCount == 1)
+    {
+        runChunk(0);
+        return;
+    }
+
+    // One job per worker pulling chunks keeps the job count low and balances uneven chunks
+    std::atomic<UInt64> nextChunk{0};
+    const auto runChunks = [&]
+    {
+        for (UInt64 chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunkCount;
+             chunk        = nextChunk.fetch_add(1, std::memory_order_relaxed))
+            runChunk(chunk);
+    };
+
+    const UInt64 helpers = std::min<UInt64>(jobs.GetWorkerCount(), chunkCount) - 1;
+    SmallArray<JobHandle, 16> handles;
+    for (UInt64 i = 0; i < helpers; i++) handles.PushBack(jobs.Schedule(runChunks));
+
+    runChunks();
+    for (const JobHandle& handle : handles) jobs.Wait(handle);
+}
+
+template <typename T, typename Func>
+void ParallelFor(JobSystem& jobs, std::span<T> range, Func&& func, UInt64 grainSize = 0)
+{
+    ParallelFor(
+        jobs, range.size(), [&](UInt64 begin, UInt64 end)
+        { for (UInt64 i = begin; i < end; i++) func(range[i]); }, grainSize);
+}
+
+template <typename T, typename Func>
+void ParallelFor(JobSystem& jobs, T* first, T* last, Func&& func, UInt64 grainSize = 0)
+{
+    ParallelFor(jobs, std::span<T>(first, last), std::forward<Func>(func), grainSize);
+}
+
+template <typename T, UInt64 N, typename Func>
+void ParallelFor(JobSystem& jobs, Array<T, N>& array, Func&& func, UInt64 grainSize = 0)
+{
+    ParallelFor(jobs, std::span<T>(array.GetData(), N), std::forward<Func>(func), grainSize);
+}
+
+template <IsContiguousContainer Container, typename Func>
+void ParallelFor(JobSystem& jobs, Container& container, Func&& func, UInt64 grainSize = 0)
+{
+    ParallelFor(jobs, std::span(container.Data(), container.Size()), std::forward<Func>(func),
+                grainSize);
+}
+
+// Folds each chunk of [0, count) with fold(Result, index) starting from identity, then merges
+// the chunk results in order with combine(Result, Result), so the result doesn't depend on
+// scheduling
+template <typename Result, typename Fold, typename Combine>
+[[nodiscard]] Result ParallelReduce(JobSystem& jobs, UInt64 count, Result identity, Fold&& fold,
+                                    Combine&& combine, UInt64 grainSize = 0)
+{
+    if (count == 0) return identity;
+    if (grainSize == 0) grainSize = jobs.GetGrainSize(count);
+
+    // One cache line per chunk so workers finishing neighbouring chunks don't share lines, the
+    // wrapper also keeps Result = bool out of the packed std::vector<bool>
+    struct alignas(64) alignas(Result) Partial
+    {
+        std::optional<Result> value{};
+    };
+
+    const UInt64 chunkCount = (count + grainSize - 1) / grainSize;
+    const auto partials     = std::make_unique<Partial[]>(chunkCount);
+    ParallelFor(
+        jobs, chunkCount,
+        [&](UInt64 chunk)
+        {
+            const UInt64 end = std::min((chunk + 1) * grainSize, count);
+            Result partial   = identity;
+            for (UInt64 i = chunk * grainSize; i < end; i++) partial = fold(std::move(partial), i);
+            partials[chunk].value.emplace(std::move(partial));
+        },
+        1);
+
+    Result result = std::move(*partials[0].value);
+    for (UInt64 i = 1; i < chunkCount; i++)
+        result = combine(std::move(result), std::move(*partials[i].value));
+    return result;
+}
+
+// fold takes (Result, element)
+template <typename T, typename Result, typename Fold, typename Combine>
+[[nodiscard]] Result ParallelReduce(JobSystem& jobs, std::span<T> range, Result identity,
+                                    Fold&& fold, Combine&& combine, UInt64 grainSize = 0)
+{
+    return ParallelReduce(
+        jobs, range.size(), std::move(identity),
+        [&](Result partial, UInt64 index) { return fold(std::move(partial), range[index]); },
+        std::forward<Combine>(combine), grainSize);
+}
+
+template <typename T, typename Result, typename Fold, typename Combine>
+[[nodiscard]] Result ParallelReduce(JobSystem& jobs, T* first, T* last, Result identity,
+                                    Fold&& fold, Combine&& combine, UInt64 grainSize = 0)
+{
+    return ParallelReduce(jobs, std::span<T>(first, last), std::move(identity),
+                          std::forward<Fold>(fold), std::forward<Combine>(combine), grainSize);
+}
+
+template <typename T, UInt64 N, typename Result, typename Fold, typename Combine>
+[[nodiscard]] Result ParallelReduce(JobSystem& jobs, Array<T, N>& array, Result identity,
+                                    Fold&& fold, Combine&& combine, UInt64 grainSize = 0)
+{
+    return ParallelReduce(jobs, std::span<T>(array.GetData(), N), std::move(identity),
+                          std::forward<Fold>(fold), std::forward<Combine>(combine), grainSize);
+}
+
+template <IsContiguousContainer Container, typename Result, typename Fold, typename Combine>
+[[nodiscard]] Result ParallelReduce(JobSystem& jobs, Container& container, Result identity,
+                                    Fold&& fold, Combine&& combine, UInt64 grainSize = 0)
+{
+    return ParallelReduce(jobs, std::span(container.Data(), container.Size()),
+                          std::move(identity), std::forward<Fold>(fold),
+                          std::forward<Combine>(combine), grainSize);
+}
+} // namespace Tez
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Memory.hxx"
+#include "Types.hxx"
+#include <algorithm>
+#include <memory_resource>
+
+namespace Tez
+{
+// Bump allocator over one fixed block. Deallocate only updates the stats, memory is reclaimed by
+// Rewind or Reset. Not thread safe.
+class LinearAllocator : public std::pmr::memory_resource
+{
+public:
+    struct Marker
+    {
+        UInt64 offset{0};
+        UInt64 bytesInUse{0};
+        UInt64 allocationCount{0};
+    };
+
+    explicit LinearAllocator(UInt64 capacity,
+                             std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    // Allocates out of a caller owned buffer
+    LinearAllocator(void* buffer, UInt64 capacity) noexcept;
+
+    LinearAllocator(const LinearAllocator&)            = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+    ~LinearAllocator() override;
+
+    [[nodiscard]]
+    void* Allocate(UInt64 bytes, UInt64 alignment = alignof(std::max_align_t)) noexcept
+    {
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(_buffer);
+        const UInt64 start        = AlignUp(base + _offset, alignment) - base;
+        if (start > _capacity || bytes > _capacity - start) return nullptr;
+
+        _offset = start + bytes;
+        _bytesInUse += bytes;
+        _peakBytesInUse = std::max(_peakBytesInUse, _bytesInUse);
+        _allocationCount++;
+        _totalAllocations++;
+        return _buffer + start;
+    }
+
+    void Deallocate(void* ptr, UInt64 bytes, [[maybe_unused]] UInt64 alignment = 0) noexcept
+    {
+        if (!ptr) return;
+
+        // Blocks past the offset were already reclaimed by Rewind or Reset, e.g. a pmr container
+        // destroyed after the frame ended
+        const UInt64 start = reinterpret_cast<std::uintptr_t>(ptr) -
+                             reinterpret_cast<std::uintptr_t>(_buffer);
+        if (start > _offset || bytes > _offset - start) return;
+
+        // A stale block that memory was handed out again over can still land here, the stats
+        // then drift but never wrap
+        _bytesInUse -= std::min(bytes, _bytesInUse);
+        if (_allocationCount > 0) _allocationCount--;
+    }
+
+    [[nodiscard]] Marker GetMarker() const noexcept
+    {
+        return Marker{
+            .offset = _offset, .bytesInUse = _bytesInUse, .allocationCount = _allocationCount};
+    }
+
+    // Frees everything allocated after the marker was taken
+    void Rewind(const Marker& marker) noexcept
+    {
+        _offset          = marker.offset;
+        _bytesInUse      = marker.bytesInUse;
+        _allocationCount = marker.allocationCount;
+    }
+
+    void Reset() noexcept { Rewind(Marker{}); }
+
+    [[nodiscard]] AllocatorStats GetStats() const noexcept;
+    [[nodiscard]] bool Owns(const void* ptr) const noexcept
+    {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+        const std::uintptr_t base    = reinterpret_cast<std::uintptr_t>(_buffer);
+        return address >= base && address < base + _capacity;
+    }
+
+    [[nodiscard]] UInt64 GetBytesInUse() const noexcept { return _bytesInUse; }
+    [[nodiscard]] UInt64 GetCapacity() const noexcept { return _capacity; }
+    [[nodiscard]] UInt64 GetRemaining() const noexcept { return _capacity - _offset; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    Byte* _buffer{nullptr};
+    UInt64 _capacity{0};
+    UInt64 _offset{0};
+    std::pmr::memory_resource* _upstream{nullptr};
+
+    UInt64 _bytesInUse{0};
+    UInt64 _peakBytesInUse{0};
+    UInt64 _allocationCount{0};
+    UInt64 _totalAllocations{0};
+};
+} // namespace Tez
@@ -1,28 +1,50 @@
 #pragma once
 
 #include "LogType.hxx"
+#include "TypeRegistry.hxx"
 #include "Types.hxx"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <format>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
-#define TEZ_LOG_INFO(message)    Tez::LogSystem::GetInstance().Log(message, LogType::INFO)
-#define TEZ_LOG_WARNING(message) Tez::LogSystem::GetInstance().Log(message, LogType::WARNING)
-#define TEZ_LOG_ERROR(message)   Tez::LogSystem::GetInstance().Log(message, LogType::ERROR)
+#if TEZ_LOG_LEVEL <= 1
+    #define TEZ_LOG_INFO(message) Tez::LogSystem::GetInstance().Log(message, Tez::LogType::INFO)
+#else
+    #define TEZ_LOG_INFO(message) ((void)0)
+#endif
+
+#if TEZ_LOG_LEVEL <= 2
+    #define TEZ_LOG_WARNING(message) \
+        Tez::LogSystem::GetInstance().Log(message, Tez::LogType::WARNING)
+#else
+    #define TEZ_LOG_WARNING(message) ((void)0)
+#endif
+
+#if TEZ_LOG_LEVEL <= 3
+    #define TEZ_LOG_ERROR(message) Tez::LogSystem::GetInstance().Log(message, Tez::LogType::ERROR)
+#else
+    #define TEZ_LOG_ERROR(message) ((void)0)
+#endif
 
 namespace Tez
 {
+struct LogFormatSite;
+class BinaryLogChannel;
 
 struct LogEntry
 {
     LogType logType{LogType::INFO};
     std::string_view message{};
     std::chrono::time_point<std::chrono::system_clock> timestamp;
+    // ReadCycleCounter() when logged, orders the entry against TEZ_LOGF_* records
+    UInt64 ticks{0};
 };
 
 class ILogChannel
@@ -36,36 +58,122 @@ public:
 template <typename T>
 concept IsChannel = std::is_base_of_v<ILogChannel, T>;
 
+// What an async Log() call does when the buffer is full
+enum class LogOverflowPolicy
+{
+    DROP      = 0, // discard the new entry
+    BLOCK     = 1, // wait for the background thread to free a slot
+    OVERWRITE = 2  // discard the oldest queued entry
+};
+
 class LogSystem
 {
 public:
+    // Async messages are copied into fixed size slots and truncated past this length
+    static constexpr UInt32 MaxMessageLength = 256;
+
     static LogSystem& GetInstance();
 
     template <IsChannel T, typename... Args>
     void AddChannel(Args&&... args);
 
+    // nullptr when no T was added
+    template <IsChannel T>
+    [[nodiscard]] T* GetChannel() const noexcept
+    {
+        return _logChannels.Get<T>();
+    }
+
     void Log(std::string_view msg, LogType logType);
 
+    // Backs the TEZ_LOGF_* macros, see BinaryLog.hxx. A BinaryLogChannel records the raw
+    // arguments, every other channel gets the formatted message through Log(). Formatting is
+    // only skipped while the BinaryLogChannel is the sole channel.
+    template <typename... Args>
+    void LogDeferred(LogFormatSite& site, std::format_string<Args...> format, Args&&... args);
+
+    // Switches Log() to a bounded lock-free queue of bufferSize entries (rounded up to a power
+    // of two, at most 2^31) drained to the channels by a background thread. Channels must be
+    // added before. Restarting after Shutdown() reuses the buffer when the size matches and
+    // reallocates it otherwise, so no Log() call from the previous run may still be in flight.
+    void StartAsync(UInt32 bufferSize = 1024, LogOverflowPolicy policy = LogOverflowPolicy::BLOCK);
+
+    // Blocks until every entry logged before the call has been handed to the channels
+    void Flush();
+
+    // Flushes and stops the background thread. Must not race with Log() calls.
+    void Shutdown();
+
+    [[nodiscard]] bool IsAsync() const noexcept { return _async.load(std::memory_order_acquire); }
+
+    [[nodiscard]] UInt64 GetDroppedCount() const noexcept
+    {
+        return _droppedCount.load(std::memory_order_relaxed);
+    }
+
 private:
+    struct alignas(64) LogSlot
+    {
+        std::atomic<UInt64> sequence{0};
+        LogType logType{LogType::INFO};
+        UInt32 length{0};
+        const ILogChannel* skippedChannel{nullptr};
+        std::chrono::time_point<std::chrono::system_clock> timestamp;
+        UInt64 ticks{0};
+        Char message[MaxMessageLength];
+    };
+
     LogSystem() = default;
+    ~LogSystem();
 
-    UInt32 _bufferSize{0xFFFFFFFFLL};
+    // Log() to every channel but skippedChannel
+    void LogExcept(std::string_view msg, LogType logType, const ILogChannel* skippedChannel);
+    void Dispatch(const LogEntry& log, const ILogChannel* skippedChannel);
+    void Enqueue(std::string_view msg, LogType logType, const ILogChannel* skippedChannel);
+    LogSlot* TryClaimOldest(UInt64& pos);
+    void ReleaseSlot(LogSlot& slot, UInt64 pos);
+    [[nodiscard]] bool HasPending() const noexcept;
+    void Signal();
+    void DrainLoop();
+
+    UInt32 _bufferSize{1024};
     std::vector<LogEntry> _logs{};
-    std::vector<std::pair<UInt64, std::unique_ptr<ILogChannel>>> _logChannels{};
+    TypeRegistry<ILogChannel> _logChannels{};
+    BinaryLogChannel* _binaryChannel{nullptr};
+
+    // Async state, the queue is a bounded MPMC ring (consumers being the drain thread and
+    // producers discarding under LogOverflowPolicy::OVERWRITE) with per slot sequence numbers
+    LogOverflowPolicy _overflowPolicy{LogOverflowPolicy::BLOCK};
+    std::unique_ptr<LogSlot[]> _slots{};
+    std::thread _drainThread{};
+    std::atomic<bool> _async{false};
+    std::atomic<bool> _stopping{false};
+    std::atomic<UInt64> _droppedCount{0};
+    alignas(64) std::atomic<UInt64> _writePos{0};
+    alignas(64) std::atomic<UInt64> _readPos{0};
+    alignas(64) std::atomic<UInt64> _drainedPos{0};
+    alignas(64) std::atomic<UInt32> _signal{0};
+    // Set while the drain thread is parked on _signal, producers only signal then
+    alignas(64) std::atomic<UInt32> _sleeping{0};
 };
 
 template <IsChannel T, typename... Args>
 void LogSystem::AddChannel(Args&&... args)
 {
-    if (std::find_if(_logChannels.begin(), _logChannels.end(), [](const auto& kvp)
-                     { return kvp.first == TypeID<T>(); }) != _logChannels.end())
+    if (IsAsync())
+    {
+        Log("Channels cannot be added while async logging is running!", LogType::WARNING);
+        return;
+    }
+
+    if (_logChannels.Contains<T>())
     {
         Log("Channel Already Exists!", LogType::WARNING);
         return;
     }
 
-    _logChannels.push_back(
-        std::pair(TypeID<T>(), std::make_unique<T>(std::forward<Args>(args)...)));
+    T* channel = _logChannels.Emplace<T>(std::forward<Args>(args)...);
+    if constexpr (std::is_base_of_v<BinaryLogChannel, T>) _binaryChannel = channel;
 }
 } // namespace Tez
 
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Types.hxx"
+#include <concepts>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+namespace Tez
+{
+[[nodiscard]] constexpr UInt64 AlignUp(UInt64 value, UInt64 alignment) noexcept
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]] inline void* AlignUp(void* ptr, UInt64 alignment) noexcept
+{
+    return reinterpret_cast<void*>(AlignUp(reinterpret_cast<std::uintptr_t>(ptr), alignment));
+}
+
+struct AllocatorStats
+{
+    UInt64 bytesInUse{0};       // requested by live allocations
+    UInt64 peakBytesInUse{0};   // highest bytesInUse since creation
+    UInt64 bytesCommitted{0};   // taken out of the reserved memory, including padding and holes
+    UInt64 bytesReserved{0};    // held from the upstream resource
+    UInt64 allocationCount{0};  // live allocations
+    UInt64 totalAllocations{0}; // since creation
+
+    // Share of committed memory not backing a live allocation
+    [[nodiscard]] constexpr Float64 Fragmentation() const noexcept
+    {
+        if (bytesCommitted == 0) return 0.0;
+        return 1.0 - static_cast<Float64>(bytesInUse) / static_cast<Float64>(bytesCommitted);
+    }
+};
+
+// Allocate returns nullptr when the resource is exhausted
+template <typename T>
+concept IsAllocatorResource = std::derived_from<T, std::pmr::memory_resource> &&
+                              requires(T& resource, void* ptr, UInt64 size) {
+                                  { resource.Allocate(size, size) } -> std::same_as<void*>;
+                                  resource.Deallocate(ptr, size, size);
+                                  { resource.GetStats() } -> std::same_as<AllocatorStats>;
+                              };
+
+// Standard allocator over one of the Core allocators, e.g.
+// DynamicArray<T, ResourceAllocator<T, FrameAllocator>> array(frameAllocator);
+// Calls are not virtual, pass the allocator itself where a std::pmr resource is expected.
+template <typename T, IsAllocatorResource Resource>
+class ResourceAllocator
+{
+public:
+    using value_type = T;
+
+    ResourceAllocator(Resource& resource) noexcept
+        : _resource{&resource}
+    {
+    }
+
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U, Resource>& other) noexcept
+        : _resource{other._resource}
+    {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t count)
+    {
+        if (count > Limits<std::size_t>::max / sizeof(T)) throw std::bad_array_new_length();
+
+        void* ptr = _resource->Allocate(count * sizeof(T), alignof(T));
+        if (!ptr) throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t count) noexcept
+    {
+        _resource->Deallocate(ptr, count * sizeof(T), alignof(T));
+    }
+
+    [[nodiscard]] Resource& GetResource() const noexcept { return *_resource; }
+
+    template <typename U>
+    [[nodiscard]] friend bool operator==(const ResourceAllocator& lhs,
+                                         const ResourceAllocator<U, Resource>& rhs) noexcept
+    {
+        return lhs._resource == rhs._resource;
+    }
+
+private:
+    template <typename, IsAllocatorResource>
+    friend class ResourceAllocator;
+
+    Resource* _resource;
+};
+} // namespace Tez
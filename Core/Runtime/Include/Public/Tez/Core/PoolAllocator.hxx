@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Memory.hxx"
+#include "Types.hxx"
+#include <algorithm>
+#include <memory_resource>
+#include <vector>
+
+namespace Tez
+{
+// Hands out fixed size blocks from chunks of blocksPerChunk blocks, freed blocks go on an
+// intrusive free list. Requests bigger or more aligned than a block go to the upstream
+// resource. Not thread safe, see GetThreadLocal.
+class PoolAllocator : public std::pmr::memory_resource
+{
+public:
+    // Largest block size served by GetThreadLocal
+    static constexpr UInt64 MaxThreadLocalBlockSize = 4096;
+
+    explicit PoolAllocator(UInt64 blockSize, UInt64 blocksPerChunk = 256,
+                           std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    PoolAllocator(const PoolAllocator&)            = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    ~PoolAllocator() override;
+
+    // The calling thread's pool for blockSize rounded up to a power of two. Its blocks must be
+    // freed on the same thread and die with it.
+    [[nodiscard]] static PoolAllocator& GetThreadLocal(UInt64 blockSize);
+
+    [[nodiscard]]
+    void* Allocate(UInt64 bytes, UInt64 alignment = alignof(std::max_align_t)) noexcept
+    {
+        if (bytes > _blockSize || alignment > _blockAlignment)
+            return AllocateOversized(bytes, alignment);
+
+        if (!_freeList && !Grow()) return nullptr;
+
+        FreeBlock* block = _freeList;
+        _freeList        = block->next;
+
+        _bytesInUse += bytes;
+        _peakBytesInUse = std::max(_peakBytesInUse, _bytesInUse + _oversizedBytes);
+        _blocksInUse++;
+        _totalAllocations++;
+        return block;
+    }
+
+    void Deallocate(void* ptr, UInt64 bytes, UInt64 alignment = alignof(std::max_align_t)) noexcept
+    {
+        if (!ptr) return;
+
+        if (bytes > _blockSize || alignment > _blockAlignment)
+        {
+            DeallocateOversized(ptr, bytes, alignment);
+            return;
+        }
+
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next      = _freeList;
+        _freeList        = block;
+
+        _bytesInUse -= bytes;
+        _blocksInUse--;
+    }
+
+    [[nodiscard]] AllocatorStats GetStats() const noexcept;
+    [[nodiscard]] UInt64 GetBlockSize() const noexcept { return _blockSize; }
+    [[nodiscard]] UInt64 GetBlockAlignment() const noexcept { return _blockAlignment; }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    bool Grow() noexcept;
+    void* AllocateOversized(UInt64 bytes, UInt64 alignment) noexcept;
+    void DeallocateOversized(void* ptr, UInt64 bytes, UInt64 alignment) noexcept;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    UInt64 _blockSize{0};
+    UInt64 _blockAlignment{0};
+    UInt64 _blocksPerChunk{0};
+    std::pmr::memory_resource* _upstream{nullptr};
+    FreeBlock* _freeList{nullptr};
+    std::vector<Byte*> _chunks{};
+
+    UInt64 _bytesInUse{0};
+    UInt64 _peakBytesInUse{0};
+    UInt64 _blocksInUse{0};
+    UInt64 _totalAllocations{0};
+    UInt64 _oversizedBytes{0};
+    UInt64 _oversizedCount{0};
+};
+} // namespace Tez
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Array.hxx"
+#include "Clock.hxx"
+#include "Config.hxx"
+#include "Log.hxx"
+#include "LogType.hxx"
+#include "Types.hxx"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define TEZ_PROFILE_CONCAT_IMPL(a, b) a##b
+#define TEZ_PROFILE_CONCAT(a, b)      TEZ_PROFILE_CONCAT_IMPL(a, b)
+
+// Times the rest of the enclosing scope, name must outlive the profiler (a literal)
+#if defined(TEZ_ENABLE_PROFILER)
+    #define TEZ_PROFILE_SCOPE(name)                                                     \
+        static constinit Tez::ProfileZone TEZ_PROFILE_CONCAT(tezProfileZone, __LINE__){ \
+            name, __FILE__, __LINE__};                                                  \
+        Tez::ProfileScope TEZ_PROFILE_CONCAT(tezProfileScope, __LINE__)(                \
+            TEZ_PROFILE_CONCAT(tezProfileZone, __LINE__))
+    #define TEZ_PROFILE_FUNCTION() TEZ_PROFILE_SCOPE(TEZ_FUNC_SIG)
+#else
+    #define TEZ_PROFILE_SCOPE(name) ((void)0)
+    #define TEZ_PROFILE_FUNCTION()  ((void)0)
+#endif
+
+namespace Tez
+{
+// One per TEZ_PROFILE_* site
+struct ProfileZone
+{
+    constexpr ProfileZone(const Char* name, const Char* file, UInt32 line)
+        : name{name}
+        , file{file}
+        , line{line}
+    {
+    }
+
+    const Char* name{nullptr};
+    const Char* file{nullptr};
+    UInt32 line{0};
+};
+
+// Begin and end in ReadCycleCounter ticks
+struct ProfileEvent
+{
+    const ProfileZone* zone{nullptr};
+    UInt64 begin{0};
+    UInt64 end{0};
+};
+
+// Aggregate of every collected event sharing a zone name, times in nanoseconds
+struct ProfileZoneStats
+{
+    std::string_view name{};
+    UInt64 count{0};
+    Float64 total{0.0};
+    Float64 min{0.0};
+    Float64 max{0.0};
+    Float64 p99{0.0};
+};
+
+// Single producer single consumer ring, written by its thread and drained by Collect()
+class ProfileThreadBuffer
+{
+public:
+    ProfileThreadBuffer(UInt32 threadID, UInt64 capacity)
+        : _threadID{threadID}
+        , _mask{capacity - 1}
+        , _events{std::make_unique<ProfileEvent[]>(capacity)}
+    {
+    }
+
+    void Push(const ProfileEvent& event) noexcept
+    {
+        const UInt64 head = _head.load(std::memory_order_relaxed);
+        if (head - _cachedTail > _mask)
+        {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head - _cachedTail > _mask)
+            {
+                _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        _events[head & _mask] = event;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    [[nodiscard]] UInt32 GetThreadID() const noexcept { return _threadID; }
+
+private:
+    friend class Profiler;
+
+    UInt32 _threadID{0};
+    UInt64 _mask{0};
+    std::unique_ptr<ProfileEvent[]> _events{};
+    std::atomic<bool> _retired{false};
+    std::atomic<UInt64> _droppedCount{0};
+    alignas(64) std::atomic<UInt64> _head{0};
+    UInt64 _cachedTail{0};
+    alignas(64) std::atomic<UInt64> _tail{0};
+};
+
+class Profiler
+{
+public:
+    // Events per thread between two Collect() calls before new ones are dropped
+    static constexpr UInt64 ThreadBufferSize = 1 << 15;
+
+    static Profiler& GetInstance();
+
+    static void Record(const ProfileZone& zone, UInt64 begin, UInt64 end) noexcept
+    {
+        ProfileThreadBuffer* buffer = _threadBuffer;
+        if (!buffer) [[unlikely]]
+        {
+            // Null once the thread is exiting, see RegisterThread
+            buffer = GetInstance().RegisterThread();
+            if (!buffer) return;
+        }
+        buffer->Push(ProfileEvent{.zone = &zone, .begin = begin, .end = end});
+    }
+
+    // Names the calling thread in the exported trace
+    void SetThreadName(std::string_view name);
+
+    // Moves the pending events of every thread into the collected set, call it once a frame
+    void Collect();
+
+    // Drops the collected events
+    void Clear();
+
+    // Collects, then writes every collected event as Chrome trace event JSON, which
+    // chrome://tracing and Perfetto open
+    bool WriteChromeTrace(const std::string& path);
+
+    // Collects, then aggregates the collected events per zone name
+    [[nodiscard]] DynamicArray<ProfileZoneStats> GetSummary();
+
+    // Logs the summary as a table, one entry per line, through every LogSystem channel
+    void Report(LogType logType = LogType::INFO);
+
+    // Same as above, straight to one channel
+    void Report(ILogChannel& channel, LogType logType = LogType::INFO);
+
+    [[nodiscard]] UInt64 GetDroppedCount() const;
+
+private:
+    struct CollectedEvent
+    {
+        ProfileEvent event{};
+        UInt32 threadID{0};
+    };
+
+    Profiler();
+
+    // Null once the thread's buffer was retired on thread exit
+    ProfileThreadBuffer* RegisterThread();
+    void CollectLocked();
+    [[nodiscard]] Float64 GetNanosecondsPerTick() const noexcept;
+    [[nodiscard]] std::vector<std::string> FormatSummary();
+
+    static thread_local ProfileThreadBuffer* _threadBuffer;
+
+    mutable std::mutex _mutex{};
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> _buffers{};
+    std::vector<CollectedEvent> _events{};
+    std::vector<std::pair<UInt32, std::string>> _threadNames{};
+    ClockCalibration _startCalibration{};
+    UInt32 _nextThreadID{0};
+    UInt64 _retiredDroppedCount{0};
+};
+
+inline thread_local ProfileThreadBuffer* Profiler::_threadBuffer{nullptr};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const ProfileZone& zone) noexcept
+        : _zone{&zone}
+        , _begin{ReadCycleCounter()}
+    {
+    }
+
+    ProfileScope(const ProfileScope&)            = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    ~ProfileScope() { Profiler::Record(*_zone, _begin, ReadCycleCounter()); }
+
+private:
+    const ProfileZone* _zone;
+    UInt64 _begin;
+};
+} // namespace Tez
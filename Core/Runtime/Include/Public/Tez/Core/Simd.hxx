@@ -0,0 +1,596 @@
+#pragma once
+
+#include "Types.hxx"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+// SIMD backed math is opt-in (TEZ_ENABLE_SIMD), AVX paths additionally need the compiler to
+// target AVX2 (-mavx2 / /arch:AVX2, see the TEZ_ENABLE_AVX2 CMake option)
+#if defined(TEZ_ENABLE_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64)
+        #define TEZ_SIMD_SSE
+    #endif
+    #if defined(__AVX2__)
+        #define TEZ_SIMD_AVX2
+    #endif
+#endif
+
+#if defined(TEZ_SIMD_SSE)
+    #include <immintrin.h>
+#endif
+
+namespace Tez::Simd
+{
+// One lane, the fallback for every type without a wide Pack and the tail of wide loops
+template <typename T>
+struct ScalarPack
+{
+    static constexpr UInt64 Width = 1;
+
+    T value;
+
+    [[nodiscard]] static ScalarPack Load(const T* data) noexcept { return {*data}; }
+    [[nodiscard]] static ScalarPack LoadUnaligned(const T* data) noexcept { return {*data}; }
+    [[nodiscard]] static ScalarPack Splat(T scalar) noexcept { return {scalar}; }
+
+    void Store(T* data) const noexcept { *data = value; }
+    void StoreUnaligned(T* data) const noexcept { *data = value; }
+
+    [[nodiscard]] T ReduceMin() const noexcept { return value; }
+    [[nodiscard]] T ReduceMax() const noexcept { return value; }
+
+    friend ScalarPack operator+(ScalarPack lhs, ScalarPack rhs) { return {lhs.value + rhs.value}; }
+    friend ScalarPack operator-(ScalarPack lhs, ScalarPack rhs) { return {lhs.value - rhs.value}; }
+    friend ScalarPack operator*(ScalarPack lhs, ScalarPack rhs) { return {lhs.value * rhs.value}; }
+    friend ScalarPack operator/(ScalarPack lhs, ScalarPack rhs) { return {lhs.value / rhs.value}; }
+
+    friend ScalarPack Sqrt(ScalarPack operand)
+    {
+        return {static_cast<T>(std::sqrt(operand.value))};
+    }
+
+    friend ScalarPack Min(ScalarPack lhs, ScalarPack rhs)
+    {
+        return {std::min(lhs.value, rhs.value)};
+    }
+
+    friend ScalarPack Max(ScalarPack lhs, ScalarPack rhs)
+    {
+        return {std::max(lhs.value, rhs.value)};
+    }
+};
+
+// Widest register for T the build targets, see Pack
+template <typename T>
+struct PackSelector
+{
+    using Type = ScalarPack<T>;
+};
+
+#if defined(TEZ_SIMD_SSE)
+// Register types are bit_cast to and from the math types through LaneTraits
+template <typename V>
+struct LaneTraits;
+
+template <typename V>
+[[nodiscard]] inline typename LaneTraits<V>::Type ToLanes(const V& value) noexcept
+{
+    return std::bit_cast<typename LaneTraits<V>::Type>(value);
+}
+
+template <typename V>
+[[nodiscard]] inline V FromLanes(typename LaneTraits<V>::Type lanes) noexcept
+{
+    return std::bit_cast<V>(lanes);
+}
+
+struct Float32x4
+{
+    __m128 value;
+
+    [[nodiscard]] static Float32x4 Splat(float scalar) noexcept { return {_mm_set1_ps(scalar)}; }
+
+    // Lane sums run in the same order as the scalar code, ((x + y) + z) + w, so results match
+    // it bit for bit
+    [[nodiscard]] float SumLanes3() const noexcept
+    {
+        __m128 sum = _mm_add_ss(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1)));
+        sum        = _mm_add_ss(sum, _mm_movehl_ps(value, value));
+        return _mm_cvtss_f32(sum);
+    }
+
+    [[nodiscard]] float SumLanes4() const noexcept
+    {
+        __m128 sum = _mm_add_ss(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1)));
+        sum        = _mm_add_ss(sum, _mm_movehl_ps(value, value));
+        sum        = _mm_add_ss(sum, _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3)));
+        return _mm_cvtss_f32(sum);
+    }
+
+    // Bit i is set when lane i of both operands compares equal
+    [[nodiscard]] static int EqualMask(Float32x4 lhs, Float32x4 rhs) noexcept
+    {
+        return _mm_movemask_ps(_mm_cmpeq_ps(lhs.value, rhs.value));
+    }
+
+    // (y, z, x, w) * (z, x, y, w) - (z, x, y, w) * (y, z, x, w)
+    [[nodiscard]] static Float32x4 Cross3(Float32x4 lhs, Float32x4 rhs) noexcept
+    {
+        const __m128 lhsYZX = _mm_shuffle_ps(lhs.value, lhs.value, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 lhsZXY = _mm_shuffle_ps(lhs.value, lhs.value, _MM_SHUFFLE(3, 1, 0, 2));
+        const __m128 rhsYZX = _mm_shuffle_ps(rhs.value, rhs.value, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 rhsZXY = _mm_shuffle_ps(rhs.value, rhs.value, _MM_SHUFFLE(3, 1, 0, 2));
+        return {_mm_sub_ps(_mm_mul_ps(lhsYZX, rhsZXY), _mm_mul_ps(lhsZXY, rhsYZX))};
+    }
+};
+
+[[nodiscard]] inline Float32x4 operator+(Float32x4 lhs, Float32x4 rhs) noexcept
+{
+    return {_mm_add_ps(lhs.value, rhs.value)};
+}
+
+[[nodiscard]] inline Float32x4 operator-(Float32x4 lhs, Float32x4 rhs) noexcept
+{
+    return {_mm_sub_ps(lhs.value, rhs.value)};
+}
+
+[[nodiscard]] inline Float32x4 operator*(Float32x4 lhs, Float32x4 rhs) noexcept
+{
+    return {_mm_mul_ps(lhs.value, rhs.value)};
+}
+
+[[nodiscard]] inline Float32x4 operator/(Float32x4 lhs, Float32x4 rhs) noexcept
+{
+    return {_mm_div_ps(lhs.value, rhs.value)};
+}
+
+[[nodiscard]] inline Float32x4 operator-(Float32x4 operand) noexcept
+{
+    return {_mm_xor_ps(operand.value, _mm_set1_ps(-0.0f))};
+}
+
+struct Float64x4
+{
+    #if defined(TEZ_SIMD_AVX2)
+    __m256d value;
+
+    [[nodiscard]] static Float64x4 Splat(double scalar) noexcept
+    {
+        return {_mm256_set1_pd(scalar)};
+    }
+
+    [[nodiscard]] double SumLanes4() const noexcept
+    {
+        const __m128d low  = _mm256_castpd256_pd128(value);
+        const __m128d high = _mm256_extractf128_pd(value, 1);
+        __m128d sum        = _mm_add_sd(low, _mm_unpackhi_pd(low, low));
+        sum                = _mm_add_sd(sum, high);
+        sum                = _mm_add_sd(sum, _mm_unpackhi_pd(high, high));
+        return _mm_cvtsd_f64(sum);
+    }
+
+    [[nodiscard]] static int EqualMask(Float64x4 lhs, Float64x4 rhs) noexcept
+    {
+        return _mm256_movemask_pd(_mm256_cmp_pd(lhs.value, rhs.value, _CMP_EQ_OQ));
+    }
+    #else
+    __m128d low;
+    __m128d high;
+
+    [[nodiscard]] static Float64x4 Splat(double scalar) noexcept
+    {
+        return {_mm_set1_pd(scalar), _mm_set1_pd(scalar)};
+    }
+
+    [[nodiscard]] double SumLanes4() const noexcept
+    {
+        __m128d sum = _mm_add_sd(low, _mm_unpackhi_pd(low, low));
+        sum         = _mm_add_sd(sum, high);
+        sum         = _mm_add_sd(sum, _mm_unpackhi_pd(high, high));
+        return _mm_cvtsd_f64(sum);
+    }
+
+    [[nodiscard]] static int EqualMask(Float64x4 lhs, Float64x4 rhs) noexcept
+    {
+        return _mm_movemask_pd(_mm_cmpeq_pd(lhs.low, rhs.low)) |
+               (_mm_movemask_pd(_mm_cmpeq_pd(lhs.high, rhs.high)) << 2);
+    }
+    #endif
+};
+
+    #if defined(TEZ_SIMD_AVX2)
+[[nodiscard]] inline Float64x4 operator+(Float64x4 lhs, Float64x4 rhs) noexcept
+{
+    return {_mm256_add_pd(lhs.value, rhs.value)};
+}
+
+[[nodiscard]] inline Float64x4 operator-(Float64x4 lhs, Float64x4 rhs) noexcept
+{
+    return {_mm256_sub_pd(lhs.value, rhs.value)};
+}
+
+[[nodiscard]] inline Float64x4 operator*(Float64x4 lhs, Float64x4 rhs) noexcept
+{
+    return {_mm256_mul_pd(lhs.value, rhs.value)};
+}
+
+[[nodiscard]] inline Float64x4 operator/(Float64x4 lhs, Float64x4 rhs) noexcept
+{
+    return {_mm256_div_pd(lhs.value, rhs.value)};
+}
+
+[[nodiscard]] inline Float64x4 operator-(Float64x4 operand) noexcept
+{
+    return {_mm256_xor_pd(operand.value, _mm256_set1_pd(-0.0))};
+}
+    #else
+[[nodiscard]] inline Float64x4 operator+(Float64x4 lhs, Float64x4 rhs) noexcept
+{
+    return {_mm_add_pd(lhs.low, rhs.low), _mm_add_pd(lhs.high, rhs.high)};
+}
+
+[[nodiscard]] inline Float64x4 operator-(Float64x4 lhs, Float64x4 rhs) noexcept
+{
+    return {_mm_sub_pd(lhs.low, rhs.low), _mm_sub_pd(lhs.high, rhs.high)};
+}
+
+[[nodiscard]] inline Float64x4 operator*(Float64x4 lhs, Float64x4 rhs) noexcept
+{
+    return {_mm_mul_pd(lhs.low, rhs.low), _mm_mul_pd(lhs.high, rhs.high)};
+}
+
+[[nodiscard]] inline Float64x4 operator/(Float64x4 lhs, Float64x4 rhs) noexcept
+{
+    return {_mm_div_pd(lhs.low, rhs.low), _mm_div_pd(lhs.high, rhs.high)};
+}
+
+[[nodiscard]] inline Float64x4 operator-(Float64x4 operand) noexcept
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    return {_mm_xor_pd(operand.low, sign), _mm_xor_pd(operand.high, sign)};
+}
+    #endif
+
+// Wide packs for streaming kernels (VectorStream), Load/Store want Width * sizeof(T) alignment
+
+    #if defined(TEZ_SIMD_AVX2)
+struct Float32x8
+{
+    static constexpr UInt64 Width = 8;
+
+    __m256 value;
+
+    [[nodiscard]] static Float32x8 Load(const Float32* data) noexcept
+    {
+        return {_mm256_load_ps(reinterpret_cast<const float*>(data))};
+    }
+
+    [[nodiscard]] static Float32x8 LoadUnaligned(const Float32* data) noexcept
+    {
+        return {_mm256_loadu_ps(reinterpret_cast<const float*>(data))};
+    }
+
+    [[nodiscard]] static Float32x8 Splat(Float32 scalar) noexcept
+    {
+        return {_mm256_set1_ps(scalar)};
+    }
+
+    void Store(Float32* data) const noexcept
+    {
+        _mm256_store_ps(reinterpret_cast<float*>(data), value);
+    }
+
+    void StoreUnaligned(Float32* data) const noexcept
+    {
+        _mm256_storeu_ps(reinterpret_cast<float*>(data), value);
+    }
+
+    [[nodiscard]] Float32 ReduceMin() const noexcept
+    {
+        __m128 lanes = _mm_min_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+        lanes        = _mm_min_ps(lanes, _mm_movehl_ps(lanes, lanes));
+        lanes        = _mm_min_ss(lanes, _mm_shuffle_ps(lanes, lanes, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(lanes);
+    }
+
+    [[nodiscard]] Float32 ReduceMax() const noexcept
+    {
+        __m128 lanes = _mm_max_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+        lanes        = _mm_max_ps(lanes, _mm_movehl_ps(lanes, lanes));
+        lanes        = _mm_max_ss(lanes, _mm_shuffle_ps(lanes, lanes, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(lanes);
+    }
+
+    friend Float32x8 operator+(Float32x8 lhs, Float32x8 rhs)
+    {
+        return {_mm256_add_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x8 operator-(Float32x8 lhs, Float32x8 rhs)
+    {
+        return {_mm256_sub_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x8 operator*(Float32x8 lhs, Float32x8 rhs)
+    {
+        return {_mm256_mul_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x8 operator/(Float32x8 lhs, Float32x8 rhs)
+    {
+        return {_mm256_div_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x8 Sqrt(Float32x8 operand) { return {_mm256_sqrt_ps(operand.value)}; }
+
+    friend Float32x8 Min(Float32x8 lhs, Float32x8 rhs)
+    {
+        return {_mm256_min_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x8 Max(Float32x8 lhs, Float32x8 rhs)
+    {
+        return {_mm256_max_ps(lhs.value, rhs.value)};
+    }
+};
+
+struct Float64x4Pack
+{
+    static constexpr UInt64 Width = 4;
+
+    __m256d value;
+
+    [[nodiscard]] static Float64x4Pack Load(const Float64* data) noexcept
+    {
+        return {_mm256_load_pd(reinterpret_cast<const double*>(data))};
+    }
+
+    [[nodiscard]] static Float64x4Pack LoadUnaligned(const Float64* data) noexcept
+    {
+        return {_mm256_loadu_pd(reinterpret_cast<const double*>(data))};
+    }
+
+    [[nodiscard]] static Float64x4Pack Splat(Float64 scalar) noexcept
+    {
+        return {_mm256_set1_pd(scalar)};
+    }
+
+    void Store(Float64* data) const noexcept
+    {
+        _mm256_store_pd(reinterpret_cast<double*>(data), value);
+    }
+
+    void StoreUnaligned(Float64* data) const noexcept
+    {
+        _mm256_storeu_pd(reinterpret_cast<double*>(data), value);
+    }
+
+    [[nodiscard]] Float64 ReduceMin() const noexcept
+    {
+        __m128d lanes = _mm_min_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+        lanes         = _mm_min_sd(lanes, _mm_unpackhi_pd(lanes, lanes));
+        return _mm_cvtsd_f64(lanes);
+    }
+
+    [[nodiscard]] Float64 ReduceMax() const noexcept
+    {
+        __m128d lanes = _mm_max_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+        lanes         = _mm_max_sd(lanes, _mm_unpackhi_pd(lanes, lanes));
+        return _mm_cvtsd_f64(lanes);
+    }
+
+    friend Float64x4Pack operator+(Float64x4Pack lhs, Float64x4Pack rhs)
+    {
+        return {_mm256_add_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x4Pack operator-(Float64x4Pack lhs, Float64x4Pack rhs)
+    {
+        return {_mm256_sub_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x4Pack operator*(Float64x4Pack lhs, Float64x4Pack rhs)
+    {
+        return {_mm256_mul_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x4Pack operator/(Float64x4Pack lhs, Float64x4Pack rhs)
+    {
+        return {_mm256_div_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x4Pack Sqrt(Float64x4Pack operand) { return {_mm256_sqrt_pd(operand.value)}; }
+
+    friend Float64x4Pack Min(Float64x4Pack lhs, Float64x4Pack rhs)
+    {
+        return {_mm256_min_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x4Pack Max(Float64x4Pack lhs, Float64x4Pack rhs)
+    {
+        return {_mm256_max_pd(lhs.value, rhs.value)};
+    }
+};
+
+template <>
+struct PackSelector<Float32>
+{
+    using Type = Float32x8;
+};
+
+template <>
+struct PackSelector<Float64>
+{
+    using Type = Float64x4Pack;
+};
+    #else
+struct Float32x4Pack
+{
+    static constexpr UInt64 Width = 4;
+
+    __m128 value;
+
+    [[nodiscard]] static Float32x4Pack Load(const Float32* data) noexcept
+    {
+        return {_mm_load_ps(reinterpret_cast<const float*>(data))};
+    }
+
+    [[nodiscard]] static Float32x4Pack LoadUnaligned(const Float32* data) noexcept
+    {
+        return {_mm_loadu_ps(reinterpret_cast<const float*>(data))};
+    }
+
+    [[nodiscard]] static Float32x4Pack Splat(Float32 scalar) noexcept
+    {
+        return {_mm_set1_ps(scalar)};
+    }
+
+    void Store(Float32* data) const noexcept
+    {
+        _mm_store_ps(reinterpret_cast<float*>(data), value);
+    }
+
+    void StoreUnaligned(Float32* data) const noexcept
+    {
+        _mm_storeu_ps(reinterpret_cast<float*>(data), value);
+    }
+
+    [[nodiscard]] Float32 ReduceMin() const noexcept
+    {
+        __m128 lanes = _mm_min_ps(value, _mm_movehl_ps(value, value));
+        lanes        = _mm_min_ss(lanes, _mm_shuffle_ps(lanes, lanes, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(lanes);
+    }
+
+    [[nodiscard]] Float32 ReduceMax() const noexcept
+    {
+        __m128 lanes = _mm_max_ps(value, _mm_movehl_ps(value, value));
+        lanes        = _mm_max_ss(lanes, _mm_shuffle_ps(lanes, lanes, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(lanes);
+    }
+
+    friend Float32x4Pack operator+(Float32x4Pack lhs, Float32x4Pack rhs)
+    {
+        return {_mm_add_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x4Pack operator-(Float32x4Pack lhs, Float32x4Pack rhs)
+    {
+        return {_mm_sub_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x4Pack operator*(Float32x4Pack lhs, Float32x4Pack rhs)
+    {
+        return {_mm_mul_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x4Pack operator/(Float32x4Pack lhs, Float32x4Pack rhs)
+    {
+        return {_mm_div_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x4Pack Sqrt(Float32x4Pack operand) { return {_mm_sqrt_ps(operand.value)}; }
+
+    friend Float32x4Pack Min(Float32x4Pack lhs, Float32x4Pack rhs)
+    {
+        return {_mm_min_ps(lhs.value, rhs.value)};
+    }
+
+    friend Float32x4Pack Max(Float32x4Pack lhs, Float32x4Pack rhs)
+    {
+        return {_mm_max_ps(lhs.value, rhs.value)};
+    }
+};
+
+struct Float64x2Pack
+{
+    static constexpr UInt64 Width = 2;
+
+    __m128d value;
+
+    [[nodiscard]] static Float64x2Pack Load(const Float64* data) noexcept
+    {
+        return {_mm_load_pd(reinterpret_cast<const double*>(data))};
+    }
+
+    [[nodiscard]] static Float64x2Pack LoadUnaligned(const Float64* data) noexcept
+    {
+        return {_mm_loadu_pd(reinterpret_cast<const double*>(data))};
+    }
+
+    [[nodiscard]] static Float64x2Pack Splat(Float64 scalar) noexcept
+    {
+        return {_mm_set1_pd(scalar)};
+    }
+
+    void Store(Float64* data) const noexcept
+    {
+        _mm_store_pd(reinterpret_cast<double*>(data), value);
+    }
+
+    void StoreUnaligned(Float64* data) const noexcept
+    {
+        _mm_storeu_pd(reinterpret_cast<double*>(data), value);
+    }
+
+    [[nodiscard]] Float64 ReduceMin() const noexcept
+    {
+        return _mm_cvtsd_f64(_mm_min_sd(value, _mm_unpackhi_pd(value, value)));
+    }
+
+    [[nodiscard]] Float64 ReduceMax() const noexcept
+    {
+        return _mm_cvtsd_f64(_mm_max_sd(value, _mm_unpackhi_pd(value, value)));
+    }
+
+    friend Float64x2Pack operator+(Float64x2Pack lhs, Float64x2Pack rhs)
+    {
+        return {_mm_add_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x2Pack operator-(Float64x2Pack lhs, Float64x2Pack rhs)
+    {
+        return {_mm_sub_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x2Pack operator*(Float64x2Pack lhs, Float64x2Pack rhs)
+    {
+        return {_mm_mul_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x2Pack operator/(Float64x2Pack lhs, Float64x2Pack rhs)
+    {
+        return {_mm_div_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x2Pack Sqrt(Float64x2Pack operand) { return {_mm_sqrt_pd(operand.value)}; }
+
+    friend Float64x2Pack Min(Float64x2Pack lhs, Float64x2Pack rhs)
+    {
+        return {_mm_min_pd(lhs.value, rhs.value)};
+    }
+
+    friend Float64x2Pack Max(Float64x2Pack lhs, Float64x2Pack rhs)
+    {
+        return {_mm_max_pd(lhs.value, rhs.value)};
+    }
+};
+
+template <>
+struct PackSelector<Float32>
+{
+    using Type = Float32x4Pack;
+};
+
+template <>
+struct PackSelector<Float64>
+{
+    using Type = Float64x2Pack;
+};
+    #endif
+#endif
+
+template <typename T>
+using Pack = typename PackSelector<T>::Type;
+} // namespace Tez::Simd
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "HashMap.hxx"
+#include "Types.hxx"
+#include <concepts>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Tez
+{
+// Owns at most one instance per concrete type derived from Base. Lookups go straight through
+// TypeID<T>(), which already is a hash, and iteration follows registration order.
+template <typename Base>
+class TypeRegistry
+{
+public:
+    using Entry = std::unique_ptr<Base>;
+
+    // Returns nullptr if a T is already registered
+    template <std::derived_from<Base> T, typename... Args>
+    T* Emplace(Args&&... args)
+    {
+        if (_indices.Contains(TypeID<T>())) return nullptr;
+
+        auto instance = std::make_unique<T>(std::forward<Args>(args)...);
+        T* result     = instance.get();
+        _entries.push_back(std::move(instance));
+        try
+        {
+            _indices.Insert(TypeID<T>(), _entries.size() - 1);
+        }
+        catch (...)
+        {
+            // No entry without an index
+            _entries.pop_back();
+            throw;
+        }
+        return result;
+    }
+
+    template <std::derived_from<Base> T>
+    [[nodiscard]] T* Get() const noexcept
+    {
+        return static_cast<T*>(Get(TypeID<T>()));
+    }
+
+    [[nodiscard]] Base* Get(UInt64 typeID) const noexcept
+    {
+        const auto it = _indices.Find(typeID);
+        return it == _indices.End() ? nullptr : _entries[it->second].get();
+    }
+
+    template <std::derived_from<Base> T>
+    [[nodiscard]] bool Contains() const noexcept
+    {
+        return _indices.Contains(TypeID<T>());
+    }
+
+    template <std::derived_from<Base> T>
+    bool Remove()
+    {
+        const auto it = _indices.Find(TypeID<T>());
+        if (it == _indices.End()) return false;
+
+        // Keeps the registration order, removals are rare
+        const UInt64 index = it->second;
+        _indices.Erase(it);
+        _entries.erase(_entries.begin() + static_cast<std::ptrdiff_t>(index));
+        for (auto& [typeID, entryIndex] : _indices)
+            if (entryIndex > index) entryIndex--;
+        return true;
+    }
+
+    void Clear() noexcept
+    {
+        _indices.Clear();
+        _entries.clear();
+    }
+
+    [[nodiscard]] UInt64 Size() const noexcept { return _entries.size(); }
+    [[nodiscard]] bool IsEmpty() const noexcept { return _entries.empty(); }
+
+    [[nodiscard]] auto begin() noexcept { return _entries.begin(); }
+    [[nodiscard]] auto begin() const noexcept { return _entries.begin(); }
+    [[nodiscard]] auto end() noexcept { return _entries.end(); }
+    [[nodiscard]] auto end() const noexcept { return _entries.end(); }
+
+private:
+    std::vector<Entry> _entries{};
+    FlatHashMap<UInt64, UInt64, IdentityHash> _indices{};
+};
+} // namespace Tez
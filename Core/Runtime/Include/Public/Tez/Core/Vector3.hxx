@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Simd.hxx"
 #include "Types.hxx"
 #include <cassert>
 #include <cmath>
@@ -27,7 +28,7 @@ public:
 
     [[nodiscard]] constexpr T Length() const { return std::sqrt(SquaredLength()); };
     [[nodiscard]] constexpr T SquaredLength() const { return x * x + y * y + z * z; }
-    [[nodiscard]] constexpr Vector3 Normalized() const { *this / Length(); }
+    [[nodiscard]] constexpr Vector3 Normalized() const { return *this / Length(); }
 
     T x{};
     T y{};
@@ -143,6 +144,192 @@ template <typename T>
                       (lhs.x * rhs.y) - (lhs.y * rhs.x));
 }
 
+#if defined(TEZ_SIMD_SSE)
+// SIMD Specializations
+// Aligned to 16 bytes so it loads as a single register. The fourth lane is the tail padding and
+// never makes it into a result, only x, y and z are members so structured bindings still work.
+// Constant evaluation falls back to the scalar code.
+
+template <>
+class alignas(16) Vector3<Float32>
+{
+public:
+    constexpr Vector3() = default;
+    constexpr Vector3(Float32 x, Float32 y, Float32 z)
+        : x{x}
+        , y{y}
+        , z{z}
+    {
+    }
+
+    template <typename U>
+    constexpr explicit operator Vector3<U>() const
+    {
+        return Vector3<U>(static_cast<U>(x), static_cast<U>(y), static_cast<U>(z));
+    }
+
+    [[nodiscard]] constexpr Float32 Length() const { return std::sqrt(SquaredLength()); }
+    [[nodiscard]] constexpr Float32 SquaredLength() const;
+    [[nodiscard]] constexpr Vector3 Normalized() const;
+
+    Float32 x{};
+    Float32 y{};
+    Float32 z{};
+};
+
+template <>
+struct Simd::LaneTraits<Vector3<Float32>>
+{
+    using Type = Simd::Float32x4;
+};
+
+[[nodiscard]] constexpr Vector3<Float32> operator-(Vector3<Float32> operand)
+{
+    if consteval
+    {
+        return Vector3<Float32>(-operand.x, -operand.y, -operand.z);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector3<Float32>>(-Simd::ToLanes(operand));
+    }
+}
+
+[[nodiscard]] constexpr Vector3<Float32> operator+(Vector3<Float32> lhs, Vector3<Float32> rhs)
+{
+    if consteval
+    {
+        return Vector3<Float32>(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector3<Float32>>(Simd::ToLanes(lhs) + Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector3<Float32> operator-(Vector3<Float32> lhs, Vector3<Float32> rhs)
+{
+    if consteval
+    {
+        return Vector3<Float32>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector3<Float32>>(Simd::ToLanes(lhs) - Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector3<Float32> operator*(Vector3<Float32> lhs, Vector3<Float32> rhs)
+{
+    if consteval
+    {
+        return Vector3<Float32>(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector3<Float32>>(Simd::ToLanes(lhs) * Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector3<Float32> operator*(Float32 lhs, Vector3<Float32> rhs)
+{
+    if consteval
+    {
+        return Vector3<Float32>(rhs.x * lhs, rhs.y * lhs, rhs.z * lhs);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector3<Float32>>(Simd::ToLanes(rhs) * Simd::Float32x4::Splat(lhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector3<Float32> operator*(Vector3<Float32> lhs, Float32 rhs)
+{
+    return rhs * lhs;
+}
+
+[[nodiscard]] constexpr Vector3<Float32> operator/(Vector3<Float32> lhs, Float32 rhs)
+{
+    assert((rhs != 0) && "Division By Zero");
+    if consteval
+    {
+        return Vector3<Float32>(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector3<Float32>>(Simd::ToLanes(lhs) / Simd::Float32x4::Splat(rhs));
+    }
+}
+
+constexpr Vector3<Float32>& operator+=(Vector3<Float32>& lhs, Vector3<Float32> rhs)
+{
+    return lhs = lhs + rhs;
+}
+
+constexpr Vector3<Float32>& operator-=(Vector3<Float32>& lhs, Vector3<Float32> rhs)
+{
+    return lhs = lhs - rhs;
+}
+
+constexpr Vector3<Float32>& operator*=(Vector3<Float32>& lhs, Float32 rhs)
+{
+    return lhs = lhs * rhs;
+}
+
+constexpr Vector3<Float32>& operator/=(Vector3<Float32>& lhs, Float32 rhs)
+{
+    return lhs = lhs / rhs;
+}
+
+[[nodiscard]] constexpr bool operator==(Vector3<Float32> lhs, Vector3<Float32> rhs)
+{
+    if consteval
+    {
+        return (lhs.x == rhs.x) && (lhs.y == rhs.y) && (lhs.z == rhs.z);
+    }
+    else
+    {
+        return (Simd::Float32x4::EqualMask(Simd::ToLanes(lhs), Simd::ToLanes(rhs)) & 0x7) == 0x7;
+    }
+}
+
+[[nodiscard]] constexpr bool operator!=(Vector3<Float32> lhs, Vector3<Float32> rhs)
+{
+    return !(lhs == rhs);
+}
+
+[[nodiscard]] constexpr Float32 Dot(const Vector3<Float32>& lhs, const Vector3<Float32>& rhs)
+{
+    if consteval
+    {
+        return (lhs.x * rhs.x) + (lhs.y * rhs.y) + (lhs.z * rhs.z);
+    }
+    else
+    {
+        return (Simd::ToLanes(lhs) * Simd::ToLanes(rhs)).SumLanes3();
+    }
+}
+
+[[nodiscard]] constexpr Vector3<Float32> Cross(const Vector3<Float32>& lhs,
+                                               const Vector3<Float32>& rhs)
+{
+    if consteval
+    {
+        return Vector3<Float32>((lhs.y * rhs.z) - (lhs.z * rhs.y),
+                                (lhs.z * rhs.x) - (lhs.x * rhs.z),
+                                (lhs.x * rhs.y) - (lhs.y * rhs.x));
+    }
+    else
+    {
+        return Simd::FromLanes<Vector3<Float32>>(
+            Simd::Float32x4::Cross3(Simd::ToLanes(lhs), Simd::ToLanes(rhs)));
+    }
+}
+
+constexpr Float32 Vector3<Float32>::SquaredLength() const { return Dot(*this, *this); }
+constexpr Vector3<Float32> Vector3<Float32>::Normalized() const { return *this / Length(); }
+#endif
+
 // Common Types
 
 using Vector3i8  = Vector3<Int8>;
@@ -165,6 +352,6 @@ struct std::formatter<Tez::Vector3<T>> : std::formatter<T>
 {
     auto format(const Tez::Vector3<T>& vec, std::format_context& ctx)
     {
-        return std::format_to(ctx.out(), "[{},{},{},{}]", vec.x, vec.y, vec.z);
+        return std::format_to(ctx.out(), "[{},{},{}]", vec.x, vec.y, vec.z);
     }
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Simd.hxx"
 #include "Types.hxx"
 #include <cassert>
 #include <cmath>
@@ -12,7 +13,13 @@ class Vector4
 {
 public:
     constexpr Vector4() = default;
-    constexpr Vector4(T x, T y, T z, T w);
+    constexpr Vector4(T x, T y, T z, T w)
+        : x{x}
+        , y{y}
+        , z{z}
+        , w{w}
+    {
+    }
 
     template <typename U>
     constexpr explicit operator Vector4<U>() const
@@ -137,6 +144,347 @@ template <typename T>
     return (lhs.x * rhs.x) + (lhs.y * rhs.y) + (lhs.z * rhs.z) + (lhs.w * rhs.w);
 }
 
+#if defined(TEZ_SIMD_SSE)
+// SIMD Specializations
+// Same API as the generic template, constant evaluation falls back to the scalar code
+
+template <>
+class alignas(16) Vector4<Float32>
+{
+public:
+    constexpr Vector4() = default;
+    constexpr Vector4(Float32 x, Float32 y, Float32 z, Float32 w)
+        : x{x}
+        , y{y}
+        , z{z}
+        , w{w}
+    {
+    }
+
+    template <typename U>
+    constexpr explicit operator Vector4<U>() const
+    {
+        return Vector4<U>(static_cast<U>(x), static_cast<U>(y), static_cast<U>(z),
+                          static_cast<U>(w));
+    }
+
+    [[nodiscard]] constexpr Float32 Length() const { return std::sqrt(SquaredLength()); }
+    [[nodiscard]] constexpr Float32 SquaredLength() const;
+    [[nodiscard]] constexpr Vector4 Normalized() const;
+
+    Float32 x{};
+    Float32 y{};
+    Float32 z{};
+    Float32 w{};
+};
+
+template <>
+class alignas(sizeof(Simd::Float64x4)) Vector4<Float64>
+{
+public:
+    constexpr Vector4() = default;
+    constexpr Vector4(Float64 x, Float64 y, Float64 z, Float64 w)
+        : x{x}
+        , y{y}
+        , z{z}
+        , w{w}
+    {
+    }
+
+    template <typename U>
+    constexpr explicit operator Vector4<U>() const
+    {
+        return Vector4<U>(static_cast<U>(x), static_cast<U>(y), static_cast<U>(z),
+                          static_cast<U>(w));
+    }
+
+    [[nodiscard]] constexpr Float64 Length() const { return std::sqrt(SquaredLength()); }
+    [[nodiscard]] constexpr Float64 SquaredLength() const;
+    [[nodiscard]] constexpr Vector4 Normalized() const;
+
+    Float64 x{};
+    Float64 y{};
+    Float64 z{};
+    Float64 w{};
+};
+
+template <>
+struct Simd::LaneTraits<Vector4<Float32>>
+{
+    using Type = Simd::Float32x4;
+};
+
+template <>
+struct Simd::LaneTraits<Vector4<Float64>>
+{
+    using Type = Simd::Float64x4;
+};
+
+// Operator Overloads (Float32)
+
+[[nodiscard]] constexpr Vector4<Float32> operator-(Vector4<Float32> operand)
+{
+    if consteval
+    {
+        return Vector4<Float32>(-operand.x, -operand.y, -operand.z, -operand.w);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float32>>(-Simd::ToLanes(operand));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float32> operator+(Vector4<Float32> lhs, Vector4<Float32> rhs)
+{
+    if consteval
+    {
+        return Vector4<Float32>(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float32>>(Simd::ToLanes(lhs) + Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float32> operator-(Vector4<Float32> lhs, Vector4<Float32> rhs)
+{
+    if consteval
+    {
+        return Vector4<Float32>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float32>>(Simd::ToLanes(lhs) - Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float32> operator*(Vector4<Float32> lhs, Vector4<Float32> rhs)
+{
+    if consteval
+    {
+        return Vector4<Float32>(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float32>>(Simd::ToLanes(lhs) * Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float32> operator*(Float32 lhs, Vector4<Float32> rhs)
+{
+    if consteval
+    {
+        return Vector4<Float32>(rhs.x * lhs, rhs.y * lhs, rhs.z * lhs, rhs.w * lhs);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float32>>(Simd::ToLanes(rhs) * Simd::Float32x4::Splat(lhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float32> operator*(Vector4<Float32> lhs, Float32 rhs)
+{
+    return rhs * lhs;
+}
+
+[[nodiscard]] constexpr Vector4<Float32> operator/(Vector4<Float32> lhs, Float32 rhs)
+{
+    assert((rhs != 0) && "Division By Zero");
+    if consteval
+    {
+        return Vector4<Float32>(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float32>>(Simd::ToLanes(lhs) / Simd::Float32x4::Splat(rhs));
+    }
+}
+
+constexpr Vector4<Float32>& operator+=(Vector4<Float32>& lhs, Vector4<Float32> rhs)
+{
+    return lhs = lhs + rhs;
+}
+
+constexpr Vector4<Float32>& operator-=(Vector4<Float32>& lhs, Vector4<Float32> rhs)
+{
+    return lhs = lhs - rhs;
+}
+
+constexpr Vector4<Float32>& operator*=(Vector4<Float32>& lhs, Float32 rhs)
+{
+    return lhs = lhs * rhs;
+}
+
+constexpr Vector4<Float32>& operator/=(Vector4<Float32>& lhs, Float32 rhs)
+{
+    return lhs = lhs / rhs;
+}
+
+[[nodiscard]] constexpr bool operator==(Vector4<Float32> lhs, Vector4<Float32> rhs)
+{
+    if consteval
+    {
+        return (lhs.x == rhs.x) && (lhs.y == rhs.y) && (lhs.z == rhs.z) && (lhs.w == rhs.w);
+    }
+    else
+    {
+        return Simd::Float32x4::EqualMask(Simd::ToLanes(lhs), Simd::ToLanes(rhs)) == 0xF;
+    }
+}
+
+[[nodiscard]] constexpr bool operator!=(Vector4<Float32> lhs, Vector4<Float32> rhs)
+{
+    return !(lhs == rhs);
+}
+
+[[nodiscard]] constexpr Float32 Dot(const Vector4<Float32>& lhs, const Vector4<Float32>& rhs)
+{
+    if consteval
+    {
+        return (lhs.x * rhs.x) + (lhs.y * rhs.y) + (lhs.z * rhs.z) + (lhs.w * rhs.w);
+    }
+    else
+    {
+        return (Simd::ToLanes(lhs) * Simd::ToLanes(rhs)).SumLanes4();
+    }
+}
+
+constexpr Float32 Vector4<Float32>::SquaredLength() const { return Dot(*this, *this); }
+constexpr Vector4<Float32> Vector4<Float32>::Normalized() const { return *this / Length(); }
+
+// Operator Overloads (Float64)
+
+[[nodiscard]] constexpr Vector4<Float64> operator-(Vector4<Float64> operand)
+{
+    if consteval
+    {
+        return Vector4<Float64>(-operand.x, -operand.y, -operand.z, -operand.w);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float64>>(-Simd::ToLanes(operand));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float64> operator+(Vector4<Float64> lhs, Vector4<Float64> rhs)
+{
+    if consteval
+    {
+        return Vector4<Float64>(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float64>>(Simd::ToLanes(lhs) + Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float64> operator-(Vector4<Float64> lhs, Vector4<Float64> rhs)
+{
+    if consteval
+    {
+        return Vector4<Float64>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float64>>(Simd::ToLanes(lhs) - Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float64> operator*(Vector4<Float64> lhs, Vector4<Float64> rhs)
+{
+    if consteval
+    {
+        return Vector4<Float64>(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float64>>(Simd::ToLanes(lhs) * Simd::ToLanes(rhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float64> operator*(Float64 lhs, Vector4<Float64> rhs)
+{
+    if consteval
+    {
+        return Vector4<Float64>(rhs.x * lhs, rhs.y * lhs, rhs.z * lhs, rhs.w * lhs);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float64>>(Simd::ToLanes(rhs) * Simd::Float64x4::Splat(lhs));
+    }
+}
+
+[[nodiscard]] constexpr Vector4<Float64> operator*(Vector4<Float64> lhs, Float64 rhs)
+{
+    return rhs * lhs;
+}
+
+[[nodiscard]] constexpr Vector4<Float64> operator/(Vector4<Float64> lhs, Float64 rhs)
+{
+    assert((rhs != 0) && "Division By Zero");
+    if consteval
+    {
+        return Vector4<Float64>(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs);
+    }
+    else
+    {
+        return Simd::FromLanes<Vector4<Float64>>(Simd::ToLanes(lhs) / Simd::Float64x4::Splat(rhs));
+    }
+}
+
+constexpr Vector4<Float64>& operator+=(Vector4<Float64>& lhs, Vector4<Float64> rhs)
+{
+    return lhs = lhs + rhs;
+}
+
+constexpr Vector4<Float64>& operator-=(Vector4<Float64>& lhs, Vector4<Float64> rhs)
+{
+    return lhs = lhs - rhs;
+}
+
+constexpr Vector4<Float64>& operator*=(Vector4<Float64>& lhs, Float64 rhs)
+{
+    return lhs = lhs * rhs;
+}
+
+constexpr Vector4<Float64>& operator/=(Vector4<Float64>& lhs, Float64 rhs)
+{
+    return lhs = lhs / rhs;
+}
+
+[[nodiscard]] constexpr bool operator==(Vector4<Float64> lhs, Vector4<Float64> rhs)
+{
+    if consteval
+    {
+        return (lhs.x == rhs.x) && (lhs.y == rhs.y) && (lhs.z == rhs.z) && (lhs.w == rhs.w);
+    }
+    else
+    {
+        return Simd::Float64x4::EqualMask(Simd::ToLanes(lhs), Simd::ToLanes(rhs)) == 0xF;
+    }
+}
+
+[[nodiscard]] constexpr bool operator!=(Vector4<Float64> lhs, Vector4<Float64> rhs)
+{
+    return !(lhs == rhs);
+}
+
+[[nodiscard]] constexpr Float64 Dot(const Vector4<Float64>& lhs, const Vector4<Float64>& rhs)
+{
+    if consteval
+    {
+        return (lhs.x * rhs.x) + (lhs.y * rhs.y) + (lhs.z * rhs.z) + (lhs.w * rhs.w);
+    }
+    else
+    {
+        return (Simd::ToLanes(lhs) * Simd::ToLanes(rhs)).SumLanes4();
+    }
+}
+
+constexpr Float64 Vector4<Float64>::SquaredLength() const { return Dot(*this, *this); }
+constexpr Vector4<Float64> Vector4<Float64>::Normalized() const { return *this / Length(); }
+#endif
+
 // Common Types
 
 using Vector4i8  = Vector4<Int8>;
@@ -0,0 +1,535 @@
+#pragma once
+
+#include "Array.hxx"
+#include "Simd.hxx"
+#include "Types.hxx"
+#include "Vector2.hxx"
+#include "Vector3.hxx"
+#include "Vector4.hxx"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Tez
+{
+// Maps a vector type to its scalar components
+template <typename V>
+struct VectorTraits;
+
+template <typename T>
+struct VectorTraits<Vector2<T>>
+{
+    using Scalar                       = T;
+    static constexpr UInt32 Components = 2;
+
+    static constexpr Vector2<T> Load(const T* const* components, UInt64 index)
+    {
+        return Vector2<T>(components[0][index], components[1][index]);
+    }
+
+    static constexpr void Store(const Vector2<T>& value, T* const* components, UInt64 index)
+    {
+        components[0][index] = value.x;
+        components[1][index] = value.y;
+    }
+};
+
+template <typename T>
+struct VectorTraits<Vector3<T>>
+{
+    using Scalar                       = T;
+    static constexpr UInt32 Components = 3;
+
+    static constexpr Vector3<T> Load(const T* const* components, UInt64 index)
+    {
+        return Vector3<T>(components[0][index], components[1][index], components[2][index]);
+    }
+
+    static constexpr void Store(const Vector3<T>& value, T* const* components, UInt64 index)
+    {
+        components[0][index] = value.x;
+        components[1][index] = value.y;
+        components[2][index] = value.z;
+    }
+};
+
+template <typename T>
+struct VectorTraits<Vector4<T>>
+{
+    using Scalar                       = T;
+    static constexpr UInt32 Components = 4;
+
+    static constexpr Vector4<T> Load(const T* const* components, UInt64 index)
+    {
+        return Vector4<T>(components[0][index], components[1][index], components[2][index],
+                          components[3][index]);
+    }
+
+    static constexpr void Store(const Vector4<T>& value, T* const* components, UInt64 index)
+    {
+        components[0][index] = value.x;
+        components[1][index] = value.y;
+        components[2][index] = value.z;
+        components[3][index] = value.w;
+    }
+};
+
+// Structure of arrays storage for vectors: every component lives in its own cache line aligned
+// array so the batch kernels below run over whole SIMD registers
+template <typename V>
+class VectorStream
+{
+public:
+    using Traits     = VectorTraits<V>;
+    using Scalar     = typename Traits::Scalar;
+    using value_type = V;
+
+    static constexpr UInt32 Components = Traits::Components;
+    static constexpr UInt64 Alignment  = 64;
+
+    // Component arrays are padded to whole cache lines, which also covers every SIMD width
+    static constexpr UInt64 Granularity = Alignment / sizeof(Scalar);
+
+    static_assert(std::is_arithmetic_v<Scalar>, "VectorStream needs arithmetic components");
+    // The SIMD packs are selected for Float32 and Float64, which are std::float32_t and
+    // std::float64_t where those exist, so float or double components would never vectorize
+    static_assert(!std::is_floating_point_v<Scalar> || std::is_same_v<Scalar, Float32> ||
+                      std::is_same_v<Scalar, Float64>,
+                  "VectorStream needs Float32 or Float64 floating point components");
+
+    VectorStream() = default;
+
+    explicit VectorStream(UInt64 count) { Resize(count); }
+
+    template <typename Allocator>
+    explicit VectorStream(const DynamicArray<V, Allocator>& array)
+    {
+        Assign(array);
+    }
+
+    VectorStream(const VectorStream& other)
+    {
+        if (other.IsEmpty()) return;
+
+        Reserve(other._size);
+        for (UInt32 c = 0; c < Components; c++)
+            std::memcpy(Component(c), other.Component(c), other._size * sizeof(Scalar));
+        _size = other._size;
+    }
+
+    VectorStream(VectorStream&& other) noexcept
+        : _data{std::exchange(other._data, nullptr)}
+        , _size{std::exchange(other._size, 0)}
+        , _capacity{std::exchange(other._capacity, 0)}
+    {
+    }
+
+    VectorStream& operator=(const VectorStream& other)
+    {
+        if (this != &other) *this = VectorStream(other);
+        return *this;
+    }
+
+    VectorStream& operator=(VectorStream&& other) noexcept
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+        return *this;
+    }
+
+    ~VectorStream() { Deallocate(_data); }
+
+    template <typename Allocator>
+    void Assign(const DynamicArray<V, Allocator>& array)
+    {
+        Resize(array.Size());
+
+        Scalar* components[Components];
+        for (UInt32 c = 0; c < Components; c++) components[c] = Component(c);
+
+        const V* data = array.Data();
+        for (UInt64 i = 0; i < _size; i++) Traits::Store(data[i], components, i);
+    }
+
+    template <typename Allocator = std::allocator<V>>
+    [[nodiscard]] DynamicArray<V, Allocator> ToArray(const Allocator& alloc = Allocator{}) const
+    {
+        DynamicArray<V, Allocator> array(_size, alloc);
+
+        const Scalar* components[Components];
+        for (UInt32 c = 0; c < Components; c++) components[c] = Component(c);
+
+        V* data = array.Data();
+        for (UInt64 i = 0; i < _size; i++) data[i] = Traits::Load(components, i);
+        return array;
+    }
+
+    void Reserve(UInt64 capacity)
+    {
+        if (capacity <= _capacity) return;
+
+        const UInt64 newCapacity = (capacity + Granularity - 1) / Granularity * Granularity;
+        Scalar* data             = Allocate(newCapacity);
+        for (UInt32 c = 0; c < Components && _size; c++)
+            std::memcpy(data + c * newCapacity, Component(c), _size * sizeof(Scalar));
+
+        Deallocate(_data);
+        _data     = data;
+        _capacity = newCapacity;
+    }
+
+    // New elements are zero
+    void Resize(UInt64 count)
+    {
+        Reserve(count);
+        if (count > _size)
+        {
+            for (UInt32 c = 0; c < Components; c++)
+                std::memset(Component(c) + _size, 0, (count - _size) * sizeof(Scalar));
+        }
+        _size = count;
+    }
+
+    void Clear() noexcept { _size = 0; }
+
+    void PushBack(const V& value)
+    {
+        if (_size == _capacity) Reserve(_capacity ? _capacity * 2 : Granularity);
+
+        Scalar* components[Components];
+        for (UInt32 c = 0; c < Components; c++) components[c] = Component(c);
+        Traits::Store(value, components, _size++);
+    }
+
+    [[nodiscard]] V Get(UInt64 index) const
+    {
+        assert((index < _size) && "Index Out of Bounds!");
+
+        const Scalar* components[Components];
+        for (UInt32 c = 0; c < Components; c++) components[c] = Component(c);
+        return Traits::Load(components, index);
+    }
+
+    void Set(UInt64 index, const V& value)
+    {
+        assert((index < _size) && "Index Out of Bounds!");
+
+        Scalar* components[Components];
+        for (UInt32 c = 0; c < Components; c++) components[c] = Component(c);
+        Traits::Store(value, components, index);
+    }
+
+    [[nodiscard]] UInt64 Size() const noexcept { return _size; }
+    [[nodiscard]] UInt64 Capacity() const noexcept { return _capacity; }
+    [[nodiscard]] bool IsEmpty() const noexcept { return _size == 0; }
+
+    [[nodiscard]] Scalar* Component(UInt32 component) noexcept
+    {
+        return _data + component * _capacity;
+    }
+
+    [[nodiscard]] const Scalar* Component(UInt32 component) const noexcept
+    {
+        return _data + component * _capacity;
+    }
+
+    [[nodiscard]] Scalar* X() noexcept { return Component(0); }
+    [[nodiscard]] const Scalar* X() const noexcept { return Component(0); }
+    [[nodiscard]] Scalar* Y() noexcept { return Component(1); }
+    [[nodiscard]] const Scalar* Y() const noexcept { return Component(1); }
+
+    [[nodiscard]] Scalar* Z() noexcept
+        requires(Components >= 3)
+    {
+        return Component(2);
+    }
+
+    [[nodiscard]] const Scalar* Z() const noexcept
+        requires(Components >= 3)
+    {
+        return Component(2);
+    }
+
+    [[nodiscard]] Scalar* W() noexcept
+        requires(Components >= 4)
+    {
+        return Component(3);
+    }
+
+    [[nodiscard]] const Scalar* W() const noexcept
+        requires(Components >= 4)
+    {
+        return Component(3);
+    }
+
+private:
+    static Scalar* Allocate(UInt64 capacity)
+    {
+        const UInt64 bytes = capacity * Components * sizeof(Scalar);
+        auto* data = static_cast<Scalar*>(::operator new(bytes, std::align_val_t{Alignment}));
+        std::memset(data, 0, bytes);
+        return data;
+    }
+
+    static void Deallocate(Scalar* data) noexcept
+    {
+        if (data) ::operator delete(data, std::align_val_t{Alignment});
+    }
+
+    Scalar* _data{nullptr};
+    UInt64 _size{0};
+    UInt64 _capacity{0};
+};
+
+// Batch Kernels
+// Outputs are resized to the input size and may alias an input
+
+// Calls kernel(Pack{}, index) over whole SIMD packs, then with single lanes for the tail
+template <typename T, typename Kernel>
+void ForEachPack(UInt64 count, Kernel&& kernel)
+{
+    using Wide = Simd::Pack<T>;
+
+    UInt64 i = 0;
+    for (; i + Wide::Width <= count; i += Wide::Width) kernel(Wide{}, i);
+    for (; i < count; i++) kernel(Simd::ScalarPack<T>{}, i);
+}
+
+template <typename V>
+void Add(VectorStream<V>& out, const VectorStream<V>& lhs, const VectorStream<V>& rhs)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    assert((lhs.Size() == rhs.Size()) && "Stream Size Mismatch");
+
+    out.Resize(lhs.Size());
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++)
+    {
+        const Scalar* a = lhs.Component(c);
+        const Scalar* b = rhs.Component(c);
+        Scalar* result  = out.Component(c);
+        ForEachPack<Scalar>(lhs.Size(), [&]<typename P>(P, UInt64 i)
+                            { (P::Load(a + i) + P::Load(b + i)).Store(result + i); });
+    }
+}
+
+template <typename V>
+void Subtract(VectorStream<V>& out, const VectorStream<V>& lhs, const VectorStream<V>& rhs)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    assert((lhs.Size() == rhs.Size()) && "Stream Size Mismatch");
+
+    out.Resize(lhs.Size());
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++)
+    {
+        const Scalar* a = lhs.Component(c);
+        const Scalar* b = rhs.Component(c);
+        Scalar* result  = out.Component(c);
+        ForEachPack<Scalar>(lhs.Size(), [&]<typename P>(P, UInt64 i)
+                            { (P::Load(a + i) - P::Load(b + i)).Store(result + i); });
+    }
+}
+
+// out = lhs * rhs + addend, component wise
+template <typename V>
+void MultiplyAdd(VectorStream<V>& out, const VectorStream<V>& lhs, const VectorStream<V>& rhs,
+                 const VectorStream<V>& addend)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    assert((lhs.Size() == rhs.Size() && lhs.Size() == addend.Size()) && "Stream Size Mismatch");
+
+    out.Resize(lhs.Size());
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++)
+    {
+        const Scalar* a = lhs.Component(c);
+        const Scalar* b = rhs.Component(c);
+        const Scalar* d = addend.Component(c);
+        Scalar* result  = out.Component(c);
+        ForEachPack<Scalar>(lhs.Size(),
+                            [&]<typename P>(P, UInt64 i)
+                            {
+                                const P product = P::Load(a + i) * P::Load(b + i);
+                                (product + P::Load(d + i)).Store(result + i);
+                            });
+    }
+}
+
+// out = lhs * scale + addend, e.g. positions + velocities * dt
+template <typename V>
+void MultiplyAdd(VectorStream<V>& out, const VectorStream<V>& lhs,
+                 typename VectorStream<V>::Scalar scale, const VectorStream<V>& addend)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    assert((lhs.Size() == addend.Size()) && "Stream Size Mismatch");
+
+    out.Resize(lhs.Size());
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++)
+    {
+        const Scalar* a = lhs.Component(c);
+        const Scalar* d = addend.Component(c);
+        Scalar* result  = out.Component(c);
+        ForEachPack<Scalar>(lhs.Size(),
+                            [&]<typename P>(P, UInt64 i)
+                            {
+                                const P product = P::Load(a + i) * P::Splat(scale);
+                                (product + P::Load(d + i)).Store(result + i);
+                            });
+    }
+}
+
+template <typename V, typename Allocator>
+void Dot(DynamicArray<typename VectorStream<V>::Scalar, Allocator>& out, const VectorStream<V>& lhs,
+         const VectorStream<V>& rhs)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    assert((lhs.Size() == rhs.Size()) && "Stream Size Mismatch");
+
+    out.Resize(lhs.Size());
+    Scalar* result = out.Data();
+    ForEachPack<Scalar>(lhs.Size(),
+                        [&]<typename P>(P, UInt64 i)
+                        {
+                            P sum = P::Load(lhs.Component(0) + i) * P::Load(rhs.Component(0) + i);
+                            for (UInt32 c = 1; c < VectorStream<V>::Components; c++)
+                            {
+                                const P a = P::Load(lhs.Component(c) + i);
+                                sum       = sum + a * P::Load(rhs.Component(c) + i);
+                            }
+                            sum.StoreUnaligned(result + i);
+                        });
+}
+
+template <typename V, typename Allocator>
+void Length(DynamicArray<typename VectorStream<V>::Scalar, Allocator>& out,
+            const VectorStream<V>& stream)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    static_assert(std::is_floating_point_v<Scalar>, "Length needs floating point components");
+
+    out.Resize(stream.Size());
+    Scalar* result = out.Data();
+    ForEachPack<Scalar>(stream.Size(),
+                        [&]<typename P>(P, UInt64 i)
+                        {
+                            P value = P::Load(stream.Component(0) + i);
+                            P sum   = value * value;
+                            for (UInt32 c = 1; c < VectorStream<V>::Components; c++)
+                            {
+                                value = P::Load(stream.Component(c) + i);
+                                sum   = sum + value * value;
+                            }
+                            Sqrt(sum).StoreUnaligned(result + i);
+                        });
+}
+
+// Same operations as V::Normalized, so results match it bit for bit
+template <typename V>
+void Normalize(VectorStream<V>& out, const VectorStream<V>& stream)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    static_assert(std::is_floating_point_v<Scalar>, "Normalize needs floating point components");
+
+    constexpr UInt32 components = VectorStream<V>::Components;
+    out.Resize(stream.Size());
+    ForEachPack<Scalar>(stream.Size(),
+                        [&]<typename P>(P, UInt64 i)
+                        {
+                            P values[components];
+                            for (UInt32 c = 0; c < components; c++)
+                                values[c] = P::Load(stream.Component(c) + i);
+
+                            P sum = values[0] * values[0];
+                            for (UInt32 c = 1; c < components; c++)
+                                sum = sum + values[c] * values[c];
+
+                            const P length = Sqrt(sum);
+                            for (UInt32 c = 0; c < components; c++)
+                                (values[c] / length).Store(out.Component(c) + i);
+                        });
+}
+
+template <typename T>
+void Cross(VectorStream<Vector3<T>>& out, const VectorStream<Vector3<T>>& lhs,
+           const VectorStream<Vector3<T>>& rhs)
+{
+    assert((lhs.Size() == rhs.Size()) && "Stream Size Mismatch");
+
+    out.Resize(lhs.Size());
+    ForEachPack<T>(lhs.Size(),
+                   [&]<typename P>(P, UInt64 i)
+                   {
+                       const P ax = P::Load(lhs.X() + i), ay = P::Load(lhs.Y() + i),
+                               az = P::Load(lhs.Z() + i);
+                       const P bx = P::Load(rhs.X() + i), by = P::Load(rhs.Y() + i),
+                               bz = P::Load(rhs.Z() + i);
+                       (ay * bz - az * by).Store(out.X() + i);
+                       (az * bx - ax * bz).Store(out.Y() + i);
+                       (ax * by - ay * bx).Store(out.Z() + i);
+                   });
+}
+
+// Component wise minimum over the whole stream, e.g. the low corner of a bounding box
+template <typename V>
+[[nodiscard]] V Min(const VectorStream<V>& stream)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    using Wide   = Simd::Pack<Scalar>;
+    assert(!stream.IsEmpty() && "Empty Stream");
+
+    Scalar result[VectorStream<V>::Components];
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++)
+    {
+        const Scalar* data = stream.Component(c);
+
+        UInt64 i = 0;
+        Scalar lowest = data[0];
+        if (stream.Size() >= Wide::Width)
+        {
+            Wide wide = Wide::Load(data);
+            for (i = Wide::Width; i + Wide::Width <= stream.Size(); i += Wide::Width)
+                wide = Min(wide, Wide::Load(data + i));
+            lowest = wide.ReduceMin();
+        }
+        for (; i < stream.Size(); i++) lowest = std::min(lowest, data[i]);
+        result[c] = lowest;
+    }
+
+    const Scalar* components[VectorStream<V>::Components];
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++) components[c] = &result[c];
+    return VectorTraits<V>::Load(components, 0);
+}
+
+// Component wise maximum over the whole stream, e.g. the high corner of a bounding box
+template <typename V>
+[[nodiscard]] V Max(const VectorStream<V>& stream)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+    using Wide   = Simd::Pack<Scalar>;
+    assert(!stream.IsEmpty() && "Empty Stream");
+
+    Scalar result[VectorStream<V>::Components];
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++)
+    {
+        const Scalar* data = stream.Component(c);
+
+        UInt64 i = 0;
+        Scalar highest = data[0];
+        if (stream.Size() >= Wide::Width)
+        {
+            Wide wide = Wide::Load(data);
+            for (i = Wide::Width; i + Wide::Width <= stream.Size(); i += Wide::Width)
+                wide = Max(wide, Wide::Load(data + i));
+            highest = wide.ReduceMax();
+        }
+        for (; i < stream.Size(); i++) highest = std::max(highest, data[i]);
+        result[c] = highest;
+    }
+
+    const Scalar* components[VectorStream<V>::Components];
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++) components[c] = &result[c];
+    return VectorTraits<V>::Load(components, 0);
+}
+} // namespace Tez
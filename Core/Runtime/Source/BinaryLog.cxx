@@ -0,0 +1,273 @@
+#include <Tez/Core/BinaryLog.hxx>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+#if defined(TEZ_PLATFORM_LINUX)
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace Tez
+{
+namespace
+{
+struct LogFormatRegistry
+{
+    std::mutex mutex{};
+    std::vector<LogFormatSite*> sites{};
+};
+
+LogFormatRegistry& GetLogFormatRegistry()
+{
+    static LogFormatRegistry registry;
+    return registry;
+}
+
+const LogFormatSite* FindLogFormat(UInt32 id)
+{
+    auto& registry = GetLogFormatRegistry();
+    std::scoped_lock lock(registry.mutex);
+    return (id > 0 && id <= registry.sites.size()) ? registry.sites[id - 1] : nullptr;
+}
+
+constexpr Char FileMagic[8] = {'T', 'E', 'Z', 'B', 'L', 'O', 'G', '\0'};
+
+std::atomic<UInt64> nextGeneration{1};
+
+// Sites for already formatted entries, indexed by LogType
+constinit LogFormatSite textSites[] = {
+    {LogType::UNKNOWN, __FILE__, __LINE__}, {LogType::INFO, __FILE__, __LINE__},
+    {LogType::WARNING, __FILE__, __LINE__}, {LogType::ERROR, __FILE__, __LINE__},
+    {LogType::ASSERT, __FILE__, __LINE__}};
+} // namespace
+
+UInt32 RegisterLogFormat(LogFormatSite& site, std::string_view format, const LogArgType* argTypes,
+                         UInt32 argCount)
+{
+    auto& registry = GetLogFormatRegistry();
+    std::scoped_lock lock(registry.mutex);
+
+    if (const UInt32 id = site.id.load(std::memory_order_relaxed)) return id;
+
+    site.format   = format;
+    site.argTypes = argTypes;
+    site.argCount = argCount;
+    registry.sites.push_back(&site);
+
+    const UInt32 id = static_cast<UInt32>(registry.sites.size());
+    site.id.store(id, std::memory_order_release);
+    return id;
+}
+
+BinaryLogChannel::BinaryLogChannel(std::string path, UInt32 chunkSize)
+    : _path{std::move(path)}
+    , _chunkSize{(std::max(chunkSize, FileHeaderSize) + FileHeaderSize - 1) / FileHeaderSize *
+                 FileHeaderSize}
+    , _generation{nextGeneration.fetch_add(1, std::memory_order_relaxed)}
+{
+    _file = std::fopen(_path.c_str(), "w+b");
+    if (!_file)
+    {
+        LogSystem::GetInstance().Log("Could not open the binary log file!", LogType::ERROR);
+        return;
+    }
+
+    _startCalibration           = ClockCalibration::Now();
+    const Int64 wallNanoseconds = ReadWallClock();
+
+    Byte header[FileHeaderSize]{};
+    std::memcpy(header, FileMagic, sizeof(FileMagic));
+    std::memcpy(header + 8, &FileVersion, sizeof(UInt32));
+    std::memcpy(header + 12, &_chunkSize, sizeof(UInt32));
+    std::memcpy(header + 16, &_startCalibration.ticks, sizeof(UInt64));
+    std::memcpy(header + 24, &_startCalibration.nanoseconds, sizeof(Int64));
+    std::memcpy(header + 48, &wallNanoseconds, sizeof(Int64));
+    std::fwrite(header, 1, FileHeaderSize, _file);
+    _fileSize = FileHeaderSize;
+    WriteCalibration();
+}
+
+BinaryLogChannel::~BinaryLogChannel()
+{
+    std::scoped_lock lock(_mutex);
+    if (!_file) return;
+
+    for (auto& chunk : _chunks) UnmapChunk(chunk);
+    _chunks.clear();
+    WriteCalibration();
+
+#if defined(TEZ_PLATFORM_LINUX)
+    // Drop the chunks reserved ahead but never handed out, they decode as empty if this fails
+    [[maybe_unused]] const int result =
+        ftruncate(fileno(_file), static_cast<off_t>(FileHeaderSize + _chunkCount * _chunkSize));
+#endif
+
+    std::fclose(_file);
+    _file = nullptr;
+}
+
+void BinaryLogChannel::OnLogReceived(const LogEntry& log)
+{
+    LogFormatSite& site = textSites[static_cast<UInt32>(log.logType)];
+    if (site.id.load(std::memory_order_acquire) == 0)
+        RegisterLogFormat(site, "{}", LogArgTypes<std::string_view>, 1);
+
+    // Entries built outside LogSystem may not carry ticks
+    const UInt64 ticks = log.ticks != 0 ? log.ticks : ReadCycleCounter();
+    WriteRecord(site, ticks | TickTimestampBit, log.message);
+}
+
+void BinaryLogChannel::Flush()
+{
+    std::scoped_lock lock(_mutex);
+    if (!_file) return;
+
+    for (auto& chunk : _chunks)
+    {
+#if defined(TEZ_PLATFORM_LINUX)
+        msync(chunk.base, _chunkSize, MS_ASYNC);
+#else
+        std::fseek(_file, static_cast<long>(FileHeaderSize + chunk.index * _chunkSize), SEEK_SET);
+        std::fwrite(chunk.base, 1, _chunkSize, _file);
+#endif
+    }
+    WriteCalibration();
+}
+
+Byte* BinaryLogChannel::ReserveSlow(UInt32 size)
+{
+    // Records never span chunks
+    if (size > _chunkSize)
+    {
+        _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    std::scoped_lock lock(_mutex);
+
+    ThreadChunk& threadChunk = _threadChunk;
+    if (threadChunk.generation == _generation) RetireChunk(threadChunk.base);
+    threadChunk = {};
+
+    Chunk chunk{.index = _chunkCount};
+    if (!_file || !MapChunk(chunk))
+    {
+        _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    _chunkCount++;
+    _chunks.push_back(chunk);
+
+    // Keeps ticks decodable if the process dies before the channel is destroyed
+    WriteCalibration();
+    threadChunk = {.generation = _generation,
+                   .base       = chunk.base,
+                   .cursor     = chunk.base + size,
+                   .end        = chunk.base + _chunkSize};
+    return chunk.base;
+}
+
+void BinaryLogChannel::WriteDefinitions(UInt32 upToID)
+{
+    std::scoped_lock lock(_definitionMutex);
+
+    for (UInt32 id = _definedCount.load(std::memory_order_relaxed) + 1; id <= upToID; id++)
+    {
+        const LogFormatSite* site = FindLogFormat(id);
+        if (!site) return;
+
+        const std::string_view file = site->file ? site->file : std::string_view();
+        const UInt16 fileLength =
+            static_cast<UInt16>(std::min<std::size_t>(file.size(), Limits<UInt16>::max));
+        const UInt32 formatLength = static_cast<UInt32>(site->format.size());
+
+        // UInt32 id, UInt32 line, UInt8 log type, UInt8 arg count, arg types,
+        // UInt16 file length, file, UInt32 format length, format
+        const UInt32 payloadSize =
+            4 + 4 + 1 + 1 + site->argCount + 2 + fileLength + 4 + formatLength;
+        Byte* out = Reserve(RecordHeaderSize + payloadSize);
+        if (!out) return;
+
+        const auto write = [&out](const void* data, std::size_t size)
+        {
+            std::memcpy(out, data, size);
+            out += size;
+        };
+
+        const UInt64 timestamp = 0;
+        const UInt8 logType   = static_cast<UInt8>(site->logType);
+        const UInt8 argCount  = static_cast<UInt8>(site->argCount);
+        write(&DefinitionRecordID, sizeof(UInt32));
+        write(&payloadSize, sizeof(UInt32));
+        write(&timestamp, sizeof(UInt64));
+        write(&id, sizeof(UInt32));
+        write(&site->line, sizeof(UInt32));
+        write(&logType, sizeof(UInt8));
+        write(&argCount, sizeof(UInt8));
+        write(site->argTypes, site->argCount);
+        write(&fileLength, sizeof(UInt16));
+        write(file.data(), fileLength);
+        write(&formatLength, sizeof(UInt32));
+        write(site->format.data(), formatLength);
+
+        _definedCount.store(id, std::memory_order_release);
+    }
+}
+
+bool BinaryLogChannel::MapChunk(Chunk& chunk)
+{
+#if defined(TEZ_PLATFORM_LINUX)
+    const UInt64 offset = FileHeaderSize + chunk.index * _chunkSize;
+    if (offset + _chunkSize > _fileSize)
+    {
+        // Grow a few chunks at a time to keep ftruncate rare
+        const UInt64 fileSize = offset + 8 * static_cast<UInt64>(_chunkSize);
+        if (ftruncate(fileno(_file), static_cast<off_t>(fileSize)) != 0) return false;
+        _fileSize = fileSize;
+    }
+
+    void* mapping = mmap(nullptr, _chunkSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(_file),
+                         static_cast<off_t>(offset));
+    if (mapping == MAP_FAILED) return false;
+
+    chunk.base = static_cast<Byte*>(mapping);
+#else
+    chunk.base = new Byte[_chunkSize]{};
+#endif
+    return true;
+}
+
+void BinaryLogChannel::UnmapChunk(Chunk& chunk)
+{
+#if defined(TEZ_PLATFORM_LINUX)
+    munmap(chunk.base, _chunkSize);
+#else
+    std::fseek(_file, static_cast<long>(FileHeaderSize + chunk.index * _chunkSize), SEEK_SET);
+    std::fwrite(chunk.base, 1, _chunkSize, _file);
+    delete[] chunk.base;
+#endif
+    chunk.base = nullptr;
+}
+
+void BinaryLogChannel::WriteCalibration()
+{
+    const ClockCalibration latest = ClockCalibration::Now();
+    std::fseek(_file, 32, SEEK_SET);
+    std::fwrite(&latest.ticks, sizeof(UInt64), 1, _file);
+    std::fwrite(&latest.nanoseconds, sizeof(Int64), 1, _file);
+    std::fflush(_file);
+}
+
+void BinaryLogChannel::RetireChunk(Byte* base)
+{
+    auto it = std::find_if(_chunks.begin(), _chunks.end(),
+                           [base](const Chunk& chunk) { return chunk.base == base; });
+    if (it == _chunks.end()) return;
+
+    UnmapChunk(*it);
+    *it = _chunks.back();
+    _chunks.pop_back();
+}
+} // namespace Tez
@@ -0,0 +1,53 @@
+#include <Tez/Core/FrameAllocator.hxx>
+#include <algorithm>
+#include <new>
+
+namespace Tez
+{
+FrameAllocator::FrameAllocator(UInt64 capacityPerFrame, std::pmr::memory_resource* upstream)
+    : _frames{LinearAllocator(capacityPerFrame, upstream),
+              LinearAllocator(capacityPerFrame, upstream)}
+{
+}
+
+void FrameAllocator::NextFrame() noexcept
+{
+    const AllocatorStats stats = GetStats();
+    _peakBytesInUse            = std::max(_peakBytesInUse, stats.bytesInUse);
+
+    _current ^= 1;
+    _frames[_current].Reset();
+    _frameIndex++;
+}
+
+AllocatorStats FrameAllocator::GetStats() const noexcept
+{
+    const AllocatorStats current  = _frames[_current].GetStats();
+    const AllocatorStats previous = _frames[_current ^ 1].GetStats();
+
+    const UInt64 bytesInUse = current.bytesInUse + previous.bytesInUse;
+    return AllocatorStats{.bytesInUse       = bytesInUse,
+                          .peakBytesInUse   = std::max(_peakBytesInUse, bytesInUse),
+                          .bytesCommitted   = current.bytesCommitted + previous.bytesCommitted,
+                          .bytesReserved    = current.bytesReserved + previous.bytesReserved,
+                          .allocationCount  = current.allocationCount + previous.allocationCount,
+                          .totalAllocations = current.totalAllocations + previous.totalAllocations};
+}
+
+void* FrameAllocator::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    void* ptr = Allocate(bytes, alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void FrameAllocator::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+{
+    Deallocate(ptr, bytes, alignment);
+}
+
+bool FrameAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+} // namespace Tez
@@ -0,0 +1,402 @@
+#include <Tez/Core/JobSystem.hxx>
+
+namespace Tez
+{
+namespace
+{
+// Continuation list of a finished job, edges added after this see the dependency as done
+JobEdge closedEdges{};
+
+// Trivially destructible, so it stays usable after the thread's jobCache was destroyed, e.g.
+// while the static JobSystem runs its leftover jobs on the exiting main thread
+thread_local bool jobCacheDestroyed{false};
+
+// Finished jobs are recycled through the releasing thread's cache
+struct JobCache
+{
+    static constexpr UInt64 MaxSize = 1024;
+
+    ~JobCache()
+    {
+        jobCacheDestroyed = true;
+        for (Job* job : jobs) delete job;
+    }
+
+    std::vector<Job*> jobs{};
+};
+
+thread_local JobCache jobCache{};
+thread_local const JobSystem* currentSystem{nullptr};
+thread_local UInt32 currentWorker{0};
+thread_local UInt64 stealSeed{0x9E3779B97F4A7C15};
+
+void ReleaseJob(Job* job) noexcept
+{
+    if (job->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    job->edges.Clear();
+    if (!jobCacheDestroyed && jobCache.jobs.size() < JobCache::MaxSize)
+        jobCache.jobs.push_back(job);
+    else
+        delete job;
+}
+
+UInt64 NextRandom() noexcept
+{
+    // xorshift64, only spreads thieves over the victims
+    stealSeed ^= stealSeed << 13;
+    stealSeed ^= stealSeed >> 7;
+    stealSeed ^= stealSeed << 17;
+    return stealSeed;
+}
+
+// Chase-Lev deque (Le et al. 2013). The owner pushes and pops at the bottom, thieves take from
+// the top. Only seq_cst operations are used instead of fences, which ThreadSanitizer follows.
+class JobDeque
+{
+public:
+    JobDeque() { _buffer.store(Grow(nullptr, 0, 0), std::memory_order_relaxed); }
+
+    void Push(Job* job)
+    {
+        const Int64 bottom = _bottom.load(std::memory_order_relaxed);
+        const Int64 top    = _top.load(std::memory_order_acquire);
+        Buffer* buffer     = _buffer.load(std::memory_order_relaxed);
+        if (bottom - top >= static_cast<Int64>(buffer->mask + 1))
+            buffer = Grow(buffer, top, bottom);
+
+        buffer->Store(bottom, job);
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    Job* Pop()
+    {
+        const Int64 bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer     = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_seq_cst);
+        Int64 top = _top.load(std::memory_order_seq_cst);
+
+        if (top > bottom)
+        {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = buffer->Load(bottom);
+        if (top == bottom)
+        {
+            // Last job, race the thieves for it
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed))
+                job = nullptr;
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* Steal()
+    {
+        Int64 top          = _top.load(std::memory_order_seq_cst);
+        const Int64 bottom = _bottom.load(std::memory_order_seq_cst);
+        if (top >= bottom) return nullptr;
+
+        Job* job = _buffer.load(std::memory_order_acquire)->Load(top);
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+            return nullptr;
+        return job;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept
+    {
+        return _top.load(std::memory_order_acquire) >= _bottom.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Buffer
+    {
+        explicit Buffer(UInt64 capacity)
+            : mask{capacity - 1}
+            , slots{std::make_unique<std::atomic<Job*>[]>(capacity)}
+        {
+        }
+
+        Job* Load(Int64 index) const noexcept
+        {
+            return slots[static_cast<UInt64>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void Store(Int64 index, Job* job) noexcept
+        {
+            slots[static_cast<UInt64>(index) & mask].store(job, std::memory_order_relaxed);
+        }
+
+        UInt64 mask;
+        std::unique_ptr<std::atomic<Job*>[]> slots;
+    };
+
+    static constexpr UInt64 InitialCapacity = 256;
+
+    // Thieves may still read a replaced buffer, so they all live as long as the deque
+    Buffer* Grow(Buffer* buffer, Int64 top, Int64 bottom)
+    {
+        auto grown = std::make_unique<Buffer>(buffer ? (buffer->mask + 1) * 2 : InitialCapacity);
+        for (Int64 i = top; i < bottom; i++) grown->Store(i, buffer->Load(i));
+
+        _buffers.push_back(std::move(grown));
+        _buffer.store(_buffers.back().get(), std::memory_order_release);
+        return _buffers.back().get();
+    }
+
+    alignas(64) std::atomic<Int64> _top{0};
+    alignas(64) std::atomic<Int64> _bottom{0};
+    std::atomic<Buffer*> _buffer{nullptr};
+    std::vector<std::unique_ptr<Buffer>> _buffers{};
+};
+} // namespace
+
+struct alignas(64) JobSystem::Worker
+{
+    JobDeque deque{};
+    std::thread thread{};
+};
+
+JobHandle::JobHandle(const JobHandle& other) noexcept
+    : _job{other._job}
+{
+    if (_job) _job->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+JobHandle& JobHandle::operator=(const JobHandle& other) noexcept
+{
+    if (other._job) other._job->references.fetch_add(1, std::memory_order_relaxed);
+    if (_job) ReleaseJob(_job);
+    _job = other._job;
+    return *this;
+}
+
+JobHandle& JobHandle::operator=(JobHandle&& other) noexcept
+{
+    if (this == &other) return *this;
+
+    if (_job) ReleaseJob(_job);
+    _job = std::exchange(other._job, nullptr);
+    return *this;
+}
+
+JobHandle::~JobHandle()
+{
+    if (_job) ReleaseJob(_job);
+}
+
+JobSystem::JobSystem(UInt32 workerCount)
+    : _workerCount{workerCount ? workerCount : std::max(std::thread::hardware_concurrency(), 1u)}
+    , _ownerThread{std::this_thread::get_id()}
+    , _workers{std::make_unique<Worker[]>(_workerCount)}
+{
+    for (UInt32 i = 1; i < _workerCount; i++)
+        _workers[i].thread = std::thread(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    _stopping.store(true, std::memory_order_seq_cst);
+    _signal.fetch_add(1, std::memory_order_seq_cst);
+    _signal.notify_all();
+
+    for (UInt32 i = 1; i < _workerCount; i++) _workers[i].thread.join();
+
+    // Leftovers can only be in the owner's deque or the injected queue now
+    while (Job* job = FindJob(0)) Execute(job);
+}
+
+JobSystem& JobSystem::GetInstance()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+void JobSystem::Wait(const JobHandle& job)
+{
+    const UInt32 workerIndex = GetWorkerIndex();
+    while (!job.IsDone())
+    {
+        if (Job* next = FindJob(workerIndex))
+            Execute(next);
+        else
+            std::this_thread::yield();
+    }
+}
+
+Job* JobSystem::AllocateJob()
+{
+    Job* job = nullptr;
+    if (!jobCacheDestroyed && !jobCache.jobs.empty())
+    {
+        job = jobCache.jobs.back();
+        jobCache.jobs.pop_back();
+    }
+    else
+    {
+        job = new Job();
+    }
+
+    // One reference for the returned handle, one held until the job finished
+    job->references.store(2, std::memory_order_relaxed);
+    job->done.store(false, std::memory_order_relaxed);
+    job->continuations.store(nullptr, std::memory_order_relaxed);
+    return job;
+}
+
+JobHandle JobSystem::Submit(Job* job, std::span<const JobHandle> dependencies)
+{
+    // The extra count keeps the job from starting while its edges are being linked
+    job->pendingDependencies.store(static_cast<UInt32>(dependencies.size()) + 1,
+                                   std::memory_order_relaxed);
+    job->edges.Reserve(dependencies.size());
+
+    for (const JobHandle& dependency : dependencies)
+    {
+        Job* before = dependency._job;
+        if (!before)
+        {
+            job->pendingDependencies.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        job->edges.PushBack(JobEdge{.job = job});
+        JobEdge* edge = &job->edges.Back();
+        JobEdge* head = before->continuations.load(std::memory_order_acquire);
+        do
+        {
+            if (head == &closedEdges) break;
+            edge->next = head;
+        } while (!before->continuations.compare_exchange_weak(
+            head, edge, std::memory_order_acq_rel, std::memory_order_acquire));
+
+        if (head == &closedEdges) job->pendingDependencies.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) Push(job);
+
+    // The system's reference is only released in Finish, so the handle gets its own
+    return JobHandle(job);
+}
+
+void JobSystem::Push(Job* job)
+{
+    const UInt32 workerIndex = GetWorkerIndex();
+    if (workerIndex != NoWorker)
+    {
+        _workers[workerIndex].deque.Push(job);
+    }
+    else
+    {
+        std::scoped_lock lock(_injectedMutex);
+        _injected.push_back(job);
+        _injectedCount.fetch_add(1, std::memory_order_release);
+    }
+
+    _signal.fetch_add(1, std::memory_order_seq_cst);
+    if (_sleeping.load(std::memory_order_seq_cst) > 0) _signal.notify_one();
+}
+
+Job* JobSystem::FindJob(UInt32 workerIndex)
+{
+    if (workerIndex != NoWorker)
+    {
+        if (Job* job = _workers[workerIndex].deque.Pop()) return job;
+    }
+
+    if (_injectedCount.load(std::memory_order_acquire) > 0)
+    {
+        std::scoped_lock lock(_injectedMutex);
+        if (!_injected.empty())
+        {
+            Job* job = _injected.back();
+            _injected.pop_back();
+            _injectedCount.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    const UInt32 start = static_cast<UInt32>(NextRandom() % _workerCount);
+    for (UInt32 i = 0; i < _workerCount; i++)
+    {
+        const UInt32 victim = (start + i) % _workerCount;
+        if (victim == workerIndex) continue;
+        if (Job* job = _workers[victim].deque.Steal()) return job;
+    }
+    return nullptr;
+}
+
+void JobSystem::Execute(Job* job)
+{
+    // A throwing job still finishes, so nothing depending on or waiting for it hangs
+    try
+    {
+        job->invoke(*job);
+    }
+    catch (...)
+    {
+        job->destroy(*job);
+        Finish(job);
+        throw;
+    }
+    job->destroy(*job);
+    Finish(job);
+}
+
+void JobSystem::Finish(Job* job)
+{
+    job->done.store(true, std::memory_order_release);
+
+    JobEdge* edge = job->continuations.exchange(&closedEdges, std::memory_order_acq_rel);
+    while (edge)
+    {
+        // The next pointer belongs to the continuation, read it before it can run
+        JobEdge* next = edge->next;
+        if (edge->job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Push(edge->job);
+        edge = next;
+    }
+
+    ReleaseJob(job);
+}
+
+void JobSystem::WorkerLoop(UInt32 workerIndex)
+{
+    currentSystem = this;
+    currentWorker = workerIndex;
+
+    while (true)
+    {
+        const UInt32 signal = _signal.load(std::memory_order_seq_cst);
+        if (Job* job = FindJob(workerIndex))
+        {
+            Execute(job);
+            continue;
+        }
+
+        if (_stopping.load(std::memory_order_seq_cst)) return;
+
+        // Look once more after announcing the sleep, a Push in between either shows up here
+        // or sees the sleeper and changes the signal
+        _sleeping.fetch_add(1, std::memory_order_seq_cst);
+        if (Job* job = FindJob(workerIndex))
+        {
+            _sleeping.fetch_sub(1, std::memory_order_relaxed);
+            Execute(job);
+            continue;
+        }
+        _signal.wait(signal, std::memory_order_seq_cst);
+        _sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+UInt32 JobSystem::GetWorkerIndex() const noexcept
+{
+    if (currentSystem == this) return currentWorker;
+    return std::this_thread::get_id() == _ownerThread ? 0 : NoWorker;
+}
+} // namespace Tez
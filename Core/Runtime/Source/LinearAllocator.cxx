@@ -0,0 +1,50 @@
+#include <Tez/Core/LinearAllocator.hxx>
+#include <new>
+
+namespace Tez
+{
+LinearAllocator::LinearAllocator(UInt64 capacity, std::pmr::memory_resource* upstream)
+    : _buffer{static_cast<Byte*>(upstream->allocate(capacity, alignof(std::max_align_t)))}
+    , _capacity{capacity}
+    , _upstream{upstream}
+{
+}
+
+LinearAllocator::LinearAllocator(void* buffer, UInt64 capacity) noexcept
+    : _buffer{static_cast<Byte*>(buffer)}
+    , _capacity{capacity}
+{
+}
+
+LinearAllocator::~LinearAllocator()
+{
+    if (_upstream) _upstream->deallocate(_buffer, _capacity, alignof(std::max_align_t));
+}
+
+AllocatorStats LinearAllocator::GetStats() const noexcept
+{
+    return AllocatorStats{.bytesInUse       = _bytesInUse,
+                          .peakBytesInUse   = _peakBytesInUse,
+                          .bytesCommitted   = _offset,
+                          .bytesReserved    = _capacity,
+                          .allocationCount  = _allocationCount,
+                          .totalAllocations = _totalAllocations};
+}
+
+void* LinearAllocator::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    void* ptr = Allocate(bytes, alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void LinearAllocator::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+{
+    Deallocate(ptr, bytes, alignment);
+}
+
+bool LinearAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+} // namespace Tez
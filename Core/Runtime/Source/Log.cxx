@@ -1,6 +1,10 @@
+#include <Tez/Core/Clock.hxx>
 #include <Tez/Core/Log.hxx>
 #include <Tez/Core/LogType.hxx>
+#include <algorithm>
+#include <bit>
 #include <chrono>
+#include <cstring>
 #include <string_view>
 
 namespace Tez
@@ -11,9 +15,242 @@ LogSystem& LogSystem::GetInstance()
     return instance;
 }
 
-void LogSystem::Log(std::string_view msg, LogType type)
+LogSystem::~LogSystem() { Shutdown(); }
+
+void LogSystem::Log(std::string_view msg, LogType type) { LogExcept(msg, type, nullptr); }
+
+void LogSystem::LogExcept(std::string_view msg, LogType type, const ILogChannel* skippedChannel)
+{
+    if (IsAsync())
+    {
+        Enqueue(msg, type, skippedChannel);
+        return;
+    }
+
+    LogEntry log{.logType   = type,
+                 .message   = msg,
+                 .timestamp = std::chrono::system_clock::now(),
+                 .ticks     = ReadCycleCounter()};
+    Dispatch(log, skippedChannel);
+}
+
+void LogSystem::StartAsync(UInt32 bufferSize, LogOverflowPolicy policy)
+{
+    if (IsAsync())
+    {
+        Log("Async logging is already running!", LogType::WARNING);
+        return;
+    }
+
+    // A restart with the same size keeps the previous slots. bit_ceil is only defined up to 2^31.
+    const UInt32 size = std::bit_ceil(std::clamp<UInt32>(bufferSize, 2, UInt32{1} << 31));
+    if (!_slots || size != _bufferSize) _slots = std::make_unique<LogSlot[]>(size);
+
+    _bufferSize     = size;
+    _overflowPolicy = policy;
+    for (UInt64 i = 0; i < _bufferSize; i++) _slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    _writePos.store(0, std::memory_order_relaxed);
+    _readPos.store(0, std::memory_order_relaxed);
+    _drainedPos.store(0, std::memory_order_relaxed);
+    _droppedCount.store(0, std::memory_order_relaxed);
+    _stopping.store(false, std::memory_order_relaxed);
+
+    _drainThread = std::thread(&LogSystem::DrainLoop, this);
+    _async.store(true, std::memory_order_release);
+}
+
+void LogSystem::Flush()
 {
-    LogEntry log{.logType = type, .message = msg, .timestamp = std::chrono::system_clock::now()};
-    for (auto& channel : _logChannels) { channel.second->OnLogReceived(log); }
+    // Channels logging from inside OnLogReceived would wait on themselves
+    if (!IsAsync() || std::this_thread::get_id() == _drainThread.get_id()) return;
+
+    const UInt64 target = _writePos.load(std::memory_order_acquire);
+    Signal();
+
+    UInt64 drained = _drainedPos.load(std::memory_order_acquire);
+    while (drained < target)
+    {
+        _drainedPos.wait(drained, std::memory_order_acquire);
+        drained = _drainedPos.load(std::memory_order_acquire);
+    }
+}
+
+void LogSystem::Shutdown()
+{
+    if (!IsAsync() || std::this_thread::get_id() == _drainThread.get_id()) return;
+
+    Flush();
+    _stopping.store(true, std::memory_order_release);
+    Signal();
+    _drainThread.join();
+
+    // Slots stay allocated until StartAsync() needs a different size. A Log() call still inside
+    // Enqueue() would race the next StartAsync() regardless, which is why this must not race
+    // Log().
+    _async.store(false, std::memory_order_release);
+}
+
+void LogSystem::Dispatch(const LogEntry& log, const ILogChannel* skippedChannel)
+{
+    for (auto& channel : _logChannels)
+    {
+        if (channel.get() != skippedChannel) channel->OnLogReceived(log);
+    }
+}
+
+void LogSystem::Enqueue(std::string_view msg, LogType type, const ILogChannel* skippedChannel)
+{
+    const auto timestamp = std::chrono::system_clock::now();
+    const UInt64 ticks   = ReadCycleCounter();
+    const UInt64 mask    = _bufferSize - 1;
+
+    UInt64 pos = _writePos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        LogSlot& slot    = _slots[pos & mask];
+        const UInt64 seq = slot.sequence.load(std::memory_order_acquire);
+        const Int64 diff = static_cast<Int64>(seq - pos);
+
+        if (diff == 0)
+        {
+            if (!_writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                continue;
+
+            const UInt32 length =
+                static_cast<UInt32>(std::min<std::size_t>(msg.size(), MaxMessageLength));
+            std::memcpy(slot.message, msg.data(), length);
+            slot.length         = length;
+            slot.logType        = type;
+            slot.timestamp      = timestamp;
+            slot.ticks          = ticks;
+            slot.skippedChannel = skippedChannel;
+
+            // Only a parked drain thread needs the shared signal line touched, see DrainLoop
+            slot.sequence.store(pos + 1, std::memory_order_seq_cst);
+            if (_sleeping.load(std::memory_order_seq_cst) > 0) Signal();
+            return;
+        }
+
+        if (diff < 0)
+        {
+            // The slot still holds an entry from the previous lap, the buffer is full
+            switch (_overflowPolicy)
+            {
+            case LogOverflowPolicy::DROP:
+                _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            case LogOverflowPolicy::OVERWRITE:
+            {
+                UInt64 oldest = 0;
+                if (LogSlot* victim = TryClaimOldest(oldest))
+                {
+                    ReleaseSlot(*victim, oldest);
+                    _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    // The oldest entry is still being written
+                    std::this_thread::yield();
+                }
+                break;
+            }
+            case LogOverflowPolicy::BLOCK:
+                // The drain thread can't wait on itself
+                if (std::this_thread::get_id() == _drainThread.get_id())
+                {
+                    _droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                std::this_thread::yield();
+                break;
+            }
+        }
+
+        pos = _writePos.load(std::memory_order_relaxed);
+    }
+}
+
+LogSystem::LogSlot* LogSystem::TryClaimOldest(UInt64& pos)
+{
+    const UInt64 mask = _bufferSize - 1;
+
+    pos = _readPos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        LogSlot& slot    = _slots[pos & mask];
+        const UInt64 seq = slot.sequence.load(std::memory_order_acquire);
+        const Int64 diff = static_cast<Int64>(seq - (pos + 1));
+
+        if (diff == 0)
+        {
+            if (_readPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return &slot;
+        }
+        else if (diff < 0)
+        {
+            // Empty, or the oldest entry is still being written
+            return nullptr;
+        }
+        else
+        {
+            pos = _readPos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void LogSystem::ReleaseSlot(LogSlot& slot, UInt64 pos)
+{
+    slot.sequence.store(pos + _bufferSize, std::memory_order_release);
+}
+
+bool LogSystem::HasPending() const noexcept
+{
+    const UInt64 pos = _readPos.load(std::memory_order_seq_cst);
+    return _slots[pos & (_bufferSize - 1)].sequence.load(std::memory_order_seq_cst) == pos + 1;
+}
+
+void LogSystem::Signal()
+{
+    _signal.fetch_add(1, std::memory_order_seq_cst);
+    _signal.notify_one();
+}
+
+void LogSystem::DrainLoop()
+{
+    while (true)
+    {
+        const UInt32 signal = _signal.load(std::memory_order_acquire);
+
+        bool drainedAny = false;
+        UInt64 pos      = 0;
+        while (LogSlot* slot = TryClaimOldest(pos))
+        {
+            LogEntry log{.logType   = slot->logType,
+                         .message   = std::string_view(slot->message, slot->length),
+                         .timestamp = slot->timestamp,
+                         .ticks     = slot->ticks};
+            Dispatch(log, slot->skippedChannel);
+            ReleaseSlot(*slot, pos);
+            drainedAny = true;
+        }
+
+        // Everything before the read position was either dispatched or overwritten
+        const UInt64 readPos = _readPos.load(std::memory_order_relaxed);
+        if (readPos != _drainedPos.load(std::memory_order_relaxed))
+        {
+            _drainedPos.store(readPos, std::memory_order_release);
+            _drainedPos.notify_all();
+        }
+
+        if (drainedAny) continue;
+        if (_stopping.load(std::memory_order_acquire)) return;
+
+        // Look once more after announcing the sleep, an Enqueue in between either shows up here
+        // or sees the sleeper and changes the signal
+        _sleeping.fetch_add(1, std::memory_order_seq_cst);
+        if (!HasPending()) _signal.wait(signal, std::memory_order_seq_cst);
+        _sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
 }
 } // namespace Tez
@@ -0,0 +1,125 @@
+#include <Tez/Core/Assert.hxx>
+#include <Tez/Core/PoolAllocator.hxx>
+#include <array>
+#include <bit>
+#include <memory>
+#include <new>
+
+namespace Tez
+{
+namespace
+{
+constexpr UInt64 ChunkAlignment = alignof(std::max_align_t);
+
+// One pool per power of two block size from sizeof(void*) up to MaxThreadLocalBlockSize
+constexpr UInt64 ThreadLocalClassCount =
+    std::countr_zero(PoolAllocator::MaxThreadLocalBlockSize) - std::countr_zero(sizeof(void*)) + 1;
+} // namespace
+
+PoolAllocator::PoolAllocator(UInt64 blockSize, UInt64 blocksPerChunk,
+                             std::pmr::memory_resource* upstream)
+    : _blockSize{AlignUp(std::max<UInt64>(blockSize, sizeof(FreeBlock)), alignof(FreeBlock))}
+    , _blocksPerChunk{std::max<UInt64>(blocksPerChunk, 1)}
+    , _upstream{upstream}
+{
+    // Chunks are max_align_t aligned, so a block is aligned to its size's lowest set bit
+    _blockAlignment = std::min(_blockSize & (~_blockSize + 1), ChunkAlignment);
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    for (Byte* chunk : _chunks)
+        _upstream->deallocate(chunk, _blockSize * _blocksPerChunk, ChunkAlignment);
+}
+
+PoolAllocator& PoolAllocator::GetThreadLocal(UInt64 blockSize)
+{
+    TEZ_HARD_ASSERT(blockSize <= MaxThreadLocalBlockSize, "Block too big for a thread local pool!");
+
+    thread_local std::array<std::unique_ptr<PoolAllocator>, ThreadLocalClassCount> pools{};
+
+    const UInt64 classSize = std::bit_ceil(std::max<UInt64>(blockSize, sizeof(void*)));
+    auto& pool = pools[std::countr_zero(classSize) - std::countr_zero(sizeof(void*))];
+    if (!pool) pool = std::make_unique<PoolAllocator>(classSize);
+    return *pool;
+}
+
+AllocatorStats PoolAllocator::GetStats() const noexcept
+{
+    return AllocatorStats{.bytesInUse       = _bytesInUse + _oversizedBytes,
+                          .peakBytesInUse   = _peakBytesInUse,
+                          .bytesCommitted   = _blocksInUse * _blockSize + _oversizedBytes,
+                          .bytesReserved    = _chunks.size() * _blocksPerChunk * _blockSize,
+                          .allocationCount  = _blocksInUse + _oversizedCount,
+                          .totalAllocations = _totalAllocations};
+}
+
+bool PoolAllocator::Grow() noexcept
+{
+    const UInt64 chunkSize = _blockSize * _blocksPerChunk;
+
+    Byte* chunk = nullptr;
+    try
+    {
+        chunk = static_cast<Byte*>(_upstream->allocate(chunkSize, ChunkAlignment));
+        _chunks.push_back(chunk);
+    }
+    catch (const std::bad_alloc&)
+    {
+        if (chunk) _upstream->deallocate(chunk, chunkSize, ChunkAlignment);
+        return false;
+    }
+
+    // Thread the new blocks in address order
+    for (UInt64 i = _blocksPerChunk; i-- > 0;)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * _blockSize);
+        block->next      = _freeList;
+        _freeList        = block;
+    }
+    return true;
+}
+
+void* PoolAllocator::AllocateOversized(UInt64 bytes, UInt64 alignment) noexcept
+{
+    void* ptr = nullptr;
+    try
+    {
+        ptr = _upstream->allocate(bytes, alignment);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+
+    _oversizedBytes += bytes;
+    _oversizedCount++;
+    _totalAllocations++;
+    _peakBytesInUse = std::max(_peakBytesInUse, _bytesInUse + _oversizedBytes);
+    return ptr;
+}
+
+void PoolAllocator::DeallocateOversized(void* ptr, UInt64 bytes, UInt64 alignment) noexcept
+{
+    _upstream->deallocate(ptr, bytes, alignment);
+    _oversizedBytes -= bytes;
+    _oversizedCount--;
+}
+
+void* PoolAllocator::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    void* ptr = Allocate(bytes, alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void PoolAllocator::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+{
+    Deallocate(ptr, bytes, alignment);
+}
+
+bool PoolAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+} // namespace Tez
@@ -0,0 +1,277 @@
+#include <Tez/Core/Profiler.hxx>
+#include <algorithm>
+#include <cstdio>
+#include <format>
+#include <unordered_map>
+
+namespace Tez
+{
+namespace
+{
+// Trivially destructible, so it stays usable while the thread's other thread_locals are destroyed
+thread_local bool threadExited{false};
+
+// Flags the thread's buffer on thread exit so Collect() can free it once drained. Zones opened
+// after this ran, e.g. from the destructors of other thread_locals, are dropped instead of
+// writing to a buffer Collect() may already have freed.
+struct ThreadBufferGuard
+{
+    ~ThreadBufferGuard()
+    {
+        threadExited = true;
+        if (threadBuffer) *threadBuffer = nullptr;
+        if (retired) retired->store(true, std::memory_order_release);
+    }
+
+    ProfileThreadBuffer** threadBuffer{nullptr};
+    std::atomic<bool>* retired{nullptr};
+};
+
+thread_local ThreadBufferGuard threadBufferGuard{};
+
+void WriteJsonString(std::FILE* file, std::string_view text)
+{
+    std::fputc('"', file);
+    for (const Char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            std::fputc('\\', file);
+            std::fputc(c, file);
+        }
+        else if (static_cast<UInt8>(c) < 0x20)
+        {
+            std::fprintf(file, "\\u%04x", static_cast<UInt32>(c));
+        }
+        else
+        {
+            std::fputc(c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+} // namespace
+
+Profiler::Profiler()
+    : _startCalibration{ClockCalibration::Now()}
+{
+}
+
+Profiler& Profiler::GetInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+void Profiler::SetThreadName(std::string_view name)
+{
+    ProfileThreadBuffer* buffer = _threadBuffer ? _threadBuffer : RegisterThread();
+    if (!buffer) return;
+
+    std::scoped_lock lock(_mutex);
+    _threadNames.emplace_back(buffer->GetThreadID(), std::string(name));
+}
+
+void Profiler::Collect()
+{
+    std::scoped_lock lock(_mutex);
+    CollectLocked();
+}
+
+void Profiler::Clear()
+{
+    std::scoped_lock lock(_mutex);
+    _events.clear();
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path)
+{
+    std::scoped_lock lock(_mutex);
+    CollectLocked();
+
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+    {
+        LogSystem::GetInstance().Log("Could not open the profiler trace file!", LogType::ERROR);
+        return false;
+    }
+
+    // Timestamps are microseconds since the profiler started
+    const Float64 nanosecondsPerTick = GetNanosecondsPerTick();
+    const auto toMicroseconds        = [&](UInt64 ticks)
+    {
+        return static_cast<Float64>(static_cast<Int64>(ticks - _startCalibration.ticks)) *
+               nanosecondsPerTick / 1000.0;
+    };
+
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+
+    bool first = true;
+    for (const auto& [threadID, name] : _threadNames)
+    {
+        std::fprintf(file,
+                     "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                     "\"args\":{\"name\":",
+                     first ? "" : ",", threadID);
+        WriteJsonString(file, name);
+        std::fputs("}}", file);
+        first = false;
+    }
+
+    for (const CollectedEvent& collected : _events)
+    {
+        const ProfileEvent& event = collected.event;
+        std::fprintf(file, "%s\n{\"name\":", first ? "" : ",");
+        WriteJsonString(file, event.zone->name);
+        std::fprintf(file, ",\"cat\":\"tez\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,"
+                           "\"tid\":%u,\"args\":{\"file\":",
+                     toMicroseconds(event.begin),
+                     static_cast<Float64>(event.end - event.begin) * nanosecondsPerTick / 1000.0,
+                     collected.threadID);
+        WriteJsonString(file, event.zone->file);
+        std::fprintf(file, ",\"line\":%u}}", event.zone->line);
+        first = false;
+    }
+
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
+
+DynamicArray<ProfileZoneStats> Profiler::GetSummary()
+{
+    std::scoped_lock lock(_mutex);
+    CollectLocked();
+
+    const Float64 nanosecondsPerTick = GetNanosecondsPerTick();
+    std::unordered_map<std::string_view, std::vector<UInt64>> durations;
+    for (const CollectedEvent& collected : _events)
+    {
+        const ProfileEvent& event = collected.event;
+        durations[event.zone->name].push_back(event.end - event.begin);
+    }
+
+    DynamicArray<ProfileZoneStats> summary;
+    summary.Reserve(durations.size());
+    for (auto& [name, ticks] : durations)
+    {
+        std::sort(ticks.begin(), ticks.end());
+
+        UInt64 total = 0;
+        for (const UInt64 duration : ticks) total += duration;
+
+        // Nearest rank
+        const UInt64 p99Rank = (ticks.size() * 99 + 99) / 100;
+        summary.PushBack(ProfileZoneStats{
+            .name  = name,
+            .count = ticks.size(),
+            .total = static_cast<Float64>(total) * nanosecondsPerTick,
+            .min   = static_cast<Float64>(ticks.front()) * nanosecondsPerTick,
+            .max   = static_cast<Float64>(ticks.back()) * nanosecondsPerTick,
+            .p99   = static_cast<Float64>(ticks[p99Rank - 1]) * nanosecondsPerTick});
+    }
+
+    std::sort(summary.Begin(), summary.End(),
+              [](const ProfileZoneStats& lhs, const ProfileZoneStats& rhs)
+              { return lhs.total > rhs.total; });
+    return summary;
+}
+
+void Profiler::Report(LogType logType)
+{
+    for (const std::string& line : FormatSummary()) LogSystem::GetInstance().Log(line, logType);
+}
+
+void Profiler::Report(ILogChannel& channel, LogType logType)
+{
+    const auto timestamp = std::chrono::system_clock::now();
+    const UInt64 ticks   = ReadCycleCounter();
+    for (const std::string& line : FormatSummary())
+    {
+        LogEntry log{.logType = logType, .message = line, .timestamp = timestamp, .ticks = ticks};
+        channel.OnLogReceived(log);
+    }
+}
+
+UInt64 Profiler::GetDroppedCount() const
+{
+    std::scoped_lock lock(_mutex);
+
+    UInt64 dropped = _retiredDroppedCount;
+    for (const auto& buffer : _buffers)
+        dropped += buffer->_droppedCount.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+ProfileThreadBuffer* Profiler::RegisterThread()
+{
+    if (threadExited) return nullptr;
+
+    std::scoped_lock lock(_mutex);
+
+    auto buffer = std::make_unique<ProfileThreadBuffer>(_nextThreadID++, ThreadBufferSize);
+    threadBufferGuard.threadBuffer = &_threadBuffer;
+    threadBufferGuard.retired      = &buffer->_retired;
+
+    _threadBuffer = buffer.get();
+    _buffers.push_back(std::move(buffer));
+    return _threadBuffer;
+}
+
+void Profiler::CollectLocked()
+{
+    for (UInt64 i = 0; i < _buffers.size();)
+    {
+        ProfileThreadBuffer& buffer = *_buffers[i];
+        const bool retired          = buffer._retired.load(std::memory_order_acquire);
+
+        const UInt64 head = buffer._head.load(std::memory_order_acquire);
+        UInt64 tail       = buffer._tail.load(std::memory_order_relaxed);
+        // Grows once per buffer instead of once per event, still geometrically across frames
+        const UInt64 needed = _events.size() + (head - tail);
+        if (needed > _events.capacity()) _events.reserve(std::max(needed, _events.capacity() * 2));
+        for (; tail < head; tail++)
+            _events.push_back(CollectedEvent{.event    = buffer._events[tail & buffer._mask],
+                                             .threadID = buffer._threadID});
+        buffer._tail.store(tail, std::memory_order_release);
+
+        if (retired)
+        {
+            _retiredDroppedCount += buffer._droppedCount.load(std::memory_order_relaxed);
+            _buffers[i] = std::move(_buffers.back());
+            _buffers.pop_back();
+            continue;
+        }
+        i++;
+    }
+}
+
+Float64 Profiler::GetNanosecondsPerTick() const noexcept
+{
+#if defined(TEZ_HAS_CYCLE_COUNTER)
+    const ClockCalibration now = ClockCalibration::Now();
+    if (now.ticks <= _startCalibration.ticks) return 1.0;
+
+    return static_cast<Float64>(now.nanoseconds - _startCalibration.nanoseconds) /
+           static_cast<Float64>(now.ticks - _startCalibration.ticks);
+#else
+    // Ticks are steady_clock ticks
+    return 1e9 * std::chrono::steady_clock::period::num / std::chrono::steady_clock::period::den;
+#endif
+}
+
+std::vector<std::string> Profiler::FormatSummary()
+{
+    const DynamicArray<ProfileZoneStats> summary = GetSummary();
+
+    std::vector<std::string> lines;
+    lines.push_back(std::format("{:<48} {:>10} {:>12} {:>10} {:>10} {:>10}", "Zone", "Count",
+                                "Total (ms)", "Min (us)", "Max (us)", "p99 (us)"));
+    for (const ProfileZoneStats& zone : summary)
+    {
+        lines.push_back(std::format("{:<48} {:>10} {:>12.3f} {:>10.3f} {:>10.3f} {:>10.3f}",
+                                    zone.name.substr(0, 48), zone.count, zone.total / 1e6,
+                                    zone.min / 1e3, zone.max / 1e3, zone.p99 / 1e3));
+    }
+    return lines;
+}
+} // namespace Tez
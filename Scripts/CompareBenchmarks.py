@@ -0,0 +1,105 @@
+import json
+import math
+import sys
+
+# Compares two tez-benchmarks --json result files. Every value is a time, lower is better.
+# A benchmark counts as regressed when its samples are significantly slower (two sided
+# Mann-Whitney U test) and its median moved by more than the threshold.
+DEFAULT_ALPHA = 0.01
+DEFAULT_THRESHOLD = 0.05
+
+
+def load_results(path):
+    with open(path) as file:
+        data = json.load(file)
+    results = {}
+    for benchmark in data["benchmarks"]:
+        samples = [sample for sample in benchmark["samples"] if sample is not None]
+        if samples:
+            results[benchmark["name"]] = samples
+    return data.get("context", {}), results
+
+
+def median(values):
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return (ordered[middle - 1] + ordered[middle]) / 2
+
+
+def mann_whitney_p(lhs, rhs):
+    # Normal approximation with tie correction, fine from about 8 samples per side
+    n1, n2 = len(lhs), len(rhs)
+    ranked = sorted([(value, 0) for value in lhs] + [(value, 1) for value in rhs])
+
+    ranks = [0.0] * len(ranked)
+    tie_term = 0.0
+    i = 0
+    while i < len(ranked):
+        j = i
+        while j + 1 < len(ranked) and ranked[j + 1][0] == ranked[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        ties = j - i + 1
+        tie_term += ties**3 - ties
+        i = j + 1
+
+    rank_sum = sum(rank for rank, (_, side) in zip(ranks, ranked) if side == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+
+    z = (abs(u - n1 * n2 / 2) - 0.5) / math.sqrt(variance)
+    return math.erfc(max(z, 0.0) / math.sqrt(2))
+
+
+def compare(baseline_path, candidate_path, alpha, threshold):
+    baseline_context, baseline = load_results(baseline_path)
+    candidate_context, candidate = load_results(candidate_path)
+
+    for key in ("compiler", "config", "simd", "hardware_threads"):
+        if baseline_context.get(key) != candidate_context.get(key):
+            print(f"warning: {key} differs: {baseline_context.get(key)} -> "
+                  f"{candidate_context.get(key)}")
+
+    regressions = []
+    print(f"{'Benchmark':<64} {'Baseline':>12} {'Candidate':>12} {'Change':>9} {'p':>8}")
+    for name, candidate_samples in candidate.items():
+        if name not in baseline:
+            print(f"{name:<64} {'':>12} {median(candidate_samples):>12.3f} {'new':>9}")
+            continue
+
+        baseline_samples = baseline[name]
+        before = median(baseline_samples)
+        after = median(candidate_samples)
+        change = (after - before) / before if before > 0 else 0.0
+        p = mann_whitney_p(baseline_samples, candidate_samples)
+
+        verdict = ""
+        if p < alpha and abs(change) > threshold:
+            verdict = "REGRESSION" if change > 0 else "improvement"
+            if change > 0:
+                regressions.append(name)
+        line = f"{name:<64} {before:>12.3f} {after:>12.3f} {change * 100:>+8.1f}% {p:>8.4f}"
+        print(f"{line} {verdict}".rstrip())
+
+    for name in baseline:
+        if name not in candidate:
+            print(f"{name:<64} {median(baseline[name]):>12.3f} {'':>12} {'missing':>9}")
+
+    print(f"\n{len(regressions)} regression(s) at alpha {alpha} and threshold {threshold:.0%}")
+    return regressions
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print("Usage: CompareBenchmarks.py <baseline json> <candidate json> [alpha] [threshold]")
+        sys.exit(2)
+
+    alpha = float(sys.argv[3]) if len(sys.argv) > 3 else DEFAULT_ALPHA
+    threshold = float(sys.argv[4]) if len(sys.argv) > 4 else DEFAULT_THRESHOLD
+    sys.exit(1 if compare(sys.argv[1], sys.argv[2], alpha, threshold) else 0)
@@ -0,0 +1,290 @@
+import math
+import re
+import struct
+import sys
+from datetime import datetime, timezone
+
+# Mirrors Tez::BinaryLogChannel and Tez::LogArgType in Core/.../Tez/Core/BinaryLog.hxx
+FILE_MAGIC = b"TEZBLOG\0"
+FILE_VERSION = 2
+FILE_HEADER_SIZE = 4096
+RECORD_HEADER_SIZE = 16
+DEFINITION_RECORD_ID = 0xFFFFFFFF
+TICK_TIMESTAMP_BIT = 1 << 63
+
+LOG_TYPES = ["UNKNOWN", "INFO", "WARNING", "ERROR", "ASSERT"]
+
+INT64, UINT64, FLOAT32, FLOAT64, BOOL, CHAR, STRING, POINTER = range(8)
+
+
+class FormatBool:
+    # std::format prints bools as true/false unless an integer presentation is asked for
+    def __init__(self, value):
+        self.value = value
+
+    def __format__(self, spec):
+        if spec and spec[-1] in "bBcdoxX":
+            return format(int(self.value), spec)
+        return format("true" if self.value else "false", spec)
+
+
+class FormatChar:
+    def __init__(self, value):
+        self.value = value
+
+    def __format__(self, spec):
+        if spec and spec[-1] in "bBdoxX":
+            return format(self.value, spec)
+        return format(chr(self.value), spec)
+
+
+# [[fill]align][sign][#][0][width][.precision][L][type], as std::format parses it
+FLOAT_SPEC = re.compile(r"^(?:(?P<fill>.)?(?P<align>[<>^]))?(?P<sign>[-+ ])?(?P<alt>#)?"
+                        r"(?P<zero>0)?(?P<width>\d+)?(?:\.(?P<precision>\d+))?L?"
+                        r"(?P<type>[aAeEfFgG])?$")
+
+
+def shortest_digits(value, is_float32):
+    # Shortest significand digits and decimal exponent that read back as value
+    if is_float32:
+        for precision in range(0, 9):
+            text = f"{value:.{precision}e}"
+            if struct.unpack("<f", struct.pack("<f", float(text)))[0] == value:
+                break
+    else:
+        text = f"{value:.17e}"
+        for precision in range(0, 17):
+            candidate = f"{value:.{precision}e}"
+            if float(candidate) == value:
+                text = candidate
+                break
+    mantissa, exponent = text.split("e")
+    return mantissa.replace(".", "").rstrip("0") or "0", int(exponent)
+
+
+def to_chars_shortest(value, is_float32):
+    # std::to_chars without a format: the shorter of fixed and scientific, fixed on a tie
+    digits, exponent = shortest_digits(value, is_float32)
+    scientific = digits[0] + ("." + digits[1:] if len(digits) > 1 else "") + \
+        f"e{'-' if exponent < 0 else '+'}{abs(exponent):02d}"
+    if exponent >= len(digits) - 1:
+        fixed = digits + "0" * (exponent - len(digits) + 1)
+    elif exponent >= 0:
+        fixed = digits[:exponent + 1] + "." + digits[exponent + 1:]
+    else:
+        fixed = "0." + "0" * (-exponent - 1) + digits
+    return fixed if len(fixed) <= len(scientific) else scientific
+
+
+class FormatFloat:
+    # Follows std::format for floating point: no type means the shortest round trip form, or
+    # general (%g) formatting when only a precision is given
+    def __init__(self, value, is_float32):
+        self.value = value
+        self.is_float32 = is_float32
+
+    def __format__(self, spec):
+        match = FLOAT_SPEC.match(spec)
+        if not match:
+            raise ValueError(f"Invalid format spec {spec!r} for a floating point argument")
+
+        value = self.value
+        negative = math.copysign(1.0, value) < 0
+        magnitude = abs(value)
+        presentation = match["type"]
+        precision = match["precision"]
+        upper = presentation is not None and presentation.isupper()
+
+        if math.isnan(magnitude) or math.isinf(magnitude):
+            body = "nan" if math.isnan(magnitude) else "inf"
+            body = body.upper() if upper else body
+        elif presentation is None and precision is None:
+            body = to_chars_shortest(magnitude, self.is_float32)
+        elif presentation in ("a", "A"):
+            body = hex_float(magnitude, precision)
+            body = body.upper() if upper else body
+        else:
+            python_type = presentation or "g"
+            python_spec = ("#" if match["alt"] else "") + \
+                (f".{precision}" if precision is not None else "") + python_type
+            body = format(magnitude, python_spec)
+
+        # The alternate form always keeps the decimal point
+        if match["alt"] and math.isfinite(magnitude) and "." not in body:
+            exponent = body.find("e") if "p" not in body else body.find("p")
+            body = body + "." if exponent < 0 else body[:exponent] + "." + body[exponent:]
+
+        sign = "-" if negative else (match["sign"] if match["sign"] in ("+", " ") else "")
+        width = int(match["width"] or 0)
+        if match["zero"] and not match["align"] and math.isfinite(magnitude):
+            return sign + body.rjust(width - len(sign), "0")
+
+        text = sign + body
+        fill = match["fill"] or " "
+        padding = max(width - len(text), 0)
+        align = match["align"] or ">"
+        if align == "<":
+            return text + fill * padding
+        if align == "^":
+            return fill * (padding // 2) + text + fill * (padding - padding // 2)
+        return fill * padding + text
+
+
+def hex_float(magnitude, precision):
+    # std::format prints hex floats without the 0x prefix
+    text = magnitude.hex()[2:]
+    mantissa, exponent = text.split("p")
+    if precision is not None:
+        head, _, tail = mantissa.partition(".")
+        tail = (tail + "0" * int(precision))[:int(precision)]
+        mantissa = head + ("." + tail if tail else "")
+    else:
+        mantissa = mantissa.rstrip("0").rstrip(".")
+    return f"{mantissa}p{exponent}"
+
+
+class FormatPointer:
+    def __init__(self, value):
+        self.value = value
+
+    def __format__(self, spec):
+        return format(f"0x{self.value:x}", spec)
+
+
+def decode_args(arg_types, payload):
+    args = []
+    offset = 0
+    for arg_type in arg_types:
+        if arg_type == INT64:
+            args.append(struct.unpack_from("<q", payload, offset)[0])
+            offset += 8
+        elif arg_type == UINT64:
+            args.append(struct.unpack_from("<Q", payload, offset)[0])
+            offset += 8
+        elif arg_type == FLOAT32:
+            args.append(FormatFloat(struct.unpack_from("<f", payload, offset)[0], True))
+            offset += 4
+        elif arg_type == FLOAT64:
+            args.append(FormatFloat(struct.unpack_from("<d", payload, offset)[0], False))
+            offset += 8
+        elif arg_type == BOOL:
+            args.append(FormatBool(payload[offset] != 0))
+            offset += 1
+        elif arg_type == CHAR:
+            args.append(FormatChar(payload[offset]))
+            offset += 1
+        elif arg_type == STRING:
+            (length,) = struct.unpack_from("<H", payload, offset)
+            offset += 2
+            args.append(payload[offset:offset + length].decode("utf-8", errors="replace"))
+            offset += length
+        elif arg_type == POINTER:
+            args.append(FormatPointer(struct.unpack_from("<Q", payload, offset)[0]))
+            offset += 8
+        else:
+            raise ValueError(f"Unknown argument type {arg_type}")
+    return args
+
+
+def decode_definition(payload):
+    format_id, line, log_type, arg_count = struct.unpack_from("<IIBB", payload, 0)
+    offset = 10
+    arg_types = list(payload[offset:offset + arg_count])
+    offset += arg_count
+    (file_length,) = struct.unpack_from("<H", payload, offset)
+    offset += 2
+    file = payload[offset:offset + file_length].decode("utf-8", errors="replace")
+    offset += file_length
+    (format_length,) = struct.unpack_from("<I", payload, offset)
+    offset += 4
+    fmt = payload[offset:offset + format_length].decode("utf-8", errors="replace")
+    return format_id, {"line": line, "log_type": log_type, "arg_types": arg_types,
+                       "file": file, "format": fmt}
+
+
+def read_records(data, chunk_size):
+    # Yields (format id, timestamp, payload) for every record, chunk by chunk
+    for chunk_start in range(FILE_HEADER_SIZE, len(data), chunk_size):
+        chunk_end = min(chunk_start + chunk_size, len(data))
+        offset = chunk_start
+        while offset + RECORD_HEADER_SIZE <= chunk_end:
+            format_id, payload_size, timestamp = struct.unpack_from("<IIQ", data, offset)
+            if format_id == 0:
+                break
+            offset += RECORD_HEADER_SIZE
+            if offset + payload_size > chunk_end:
+                break
+            yield format_id, timestamp, data[offset:offset + payload_size]
+            offset += payload_size
+
+
+def decode_log(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if len(data) < FILE_HEADER_SIZE or data[:8] != FILE_MAGIC:
+        raise ValueError(f"{path} is not a Tez binary log")
+
+    version, chunk_size = struct.unpack_from("<II", data, 8)
+    if version != FILE_VERSION:
+        raise ValueError(f"Unsupported binary log version {version}")
+
+    # Records carry cycle counter ticks, two steady clock calibrations give the tick rate and the
+    # wall clock reading taken with the first one places them in wall time
+    start_ticks, start_ns, latest_ticks, latest_ns, wall_ns = \
+        struct.unpack_from("<QqQqq", data, 16)
+    ns_per_tick = (latest_ns - start_ns) / (latest_ticks - start_ticks) \
+        if latest_ticks > start_ticks else 1.0
+
+    def to_nanoseconds(timestamp):
+        if timestamp & TICK_TIMESTAMP_BIT:
+            ticks = timestamp & ~TICK_TIMESTAMP_BIT
+            return wall_ns + round((ticks - start_ticks) * ns_per_tick)
+        return timestamp
+
+    # Definitions can land in any thread's chunk, so collect them first
+    definitions = {}
+    entries = []
+    for format_id, timestamp, payload in read_records(data, chunk_size):
+        if format_id == DEFINITION_RECORD_ID:
+            def_id, definition = decode_definition(payload)
+            definitions[def_id] = definition
+        else:
+            entries.append((to_nanoseconds(timestamp), timestamp, format_id, payload))
+
+    # Threads write to separate chunks, restore the global order. Several ticks can round to
+    # the same nanosecond, the raw timestamp breaks those ties.
+    entries.sort(key=lambda entry: (entry[0], entry[1]))
+
+    lines = []
+    for timestamp, _, format_id, payload in entries:
+        definition = definitions.get(format_id)
+        if definition is None:
+            lines.append(f"<missing format definition {format_id}>")
+            continue
+
+        args = decode_args(definition["arg_types"], payload)
+        try:
+            message = definition["format"].format(*args)
+        except (ValueError, IndexError, KeyError) as error:
+            message = f"<{definition['format']!r} failed to format: {error}>"
+
+        time = datetime.fromtimestamp(timestamp / 1e9, tz=timezone.utc)
+        log_type = definition["log_type"]
+        level = LOG_TYPES[log_type] if log_type < len(LOG_TYPES) else "UNKNOWN"
+        lines.append(f"[{time:%Y-%m-%d %H:%M:%S}] [{level}] {message}")
+    return lines
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("Usage: DecodeBinaryLog.py <binary log> [output file]")
+        sys.exit(1)
+
+    decoded = decode_log(sys.argv[1])
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], "w") as out:
+            out.write("\n".join(decoded) + "\n")
+    else:
+        for decoded_line in decoded:
+            print(decoded_line)
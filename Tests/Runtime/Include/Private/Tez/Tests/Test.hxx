@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Tez/Core/Types.hxx>
+#include <atomic>
+#include <cstdio>
+
+// Records a failure and keeps going, so one run reports every broken check. Safe to use from any
+// thread.
+#define TEZ_CHECK(condition) \
+    ::Tez::Tests::Check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+namespace Tez::Tests
+{
+// Reported as skipped by CTest, see tez_test_target
+constexpr int SkipExitCode = 77;
+
+inline std::atomic<UInt64> failureCount{0};
+
+inline bool Check(bool condition, const Char* expression, const Char* file, int line)
+{
+    if (!condition)
+    {
+        failureCount.fetch_add(1, std::memory_order_relaxed);
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    }
+    return condition;
+}
+
+// The exit code for main()
+[[nodiscard]] inline int Result()
+{
+    const UInt64 failures = failureCount.load(std::memory_order_relaxed);
+    if (failures == 0) return 0;
+
+    std::fprintf(stderr, "%llu check(s) failed\n", static_cast<unsigned long long>(failures));
+    return 1;
+}
+} // namespace Tez::Tests
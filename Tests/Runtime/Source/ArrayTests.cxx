@@ -0,0 +1,336 @@
+#include <Tez/Core/Array.hxx>
+#include <Tez/Core/Log.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+// Both containers have to keep working in constant evaluation, spilling to the heap included
+static_assert([]
+              {
+                  SmallArray<Int32, 2> values;
+                  for (Int32 i = 0; i < 5; i++) values.PushBack(i);
+                  values.Emplace(values.Begin() + 1, 10);
+                  const Optional<Int32> last = values.PopBack();
+
+                  const SmallArray<Int32, 2> copy = values;
+                  Int32 sum                       = 0;
+                  for (const Int32 value : copy) sum += value;
+                  return !copy.IsInline() && last == 4 && copy.Size() == 5 && copy[1] == 10 &&
+                         sum == 16;
+              }());
+
+static_assert([]
+              {
+                  SmallArray<Int32, 4> values{1, 2};
+                  SmallArray<Int32, 4> moved = std::move(values);
+                  return values.IsEmpty() && moved.IsInline() && moved.Size() == 2 &&
+                         moved.Back() == 2;
+              }());
+
+static_assert([]
+              {
+                  StaticArray<Int32, 4> values{1, 2, 3};
+                  values.Emplace(values.Begin(), 0);
+                  StaticArray<Int32, 4> copy = values;
+                  const Optional<Int32> last = copy.PopBack();
+                  return values.IsFull() && copy.Size() == 3 && copy.Front() == 0 && last == 3;
+              }());
+
+struct AllocatorState
+{
+    Int64 liveBytes{0};
+};
+
+// Counts what the container holds on the heap, equal only to copies sharing the same state
+template <typename T>
+class TestAllocator
+{
+public:
+    using value_type = T;
+
+    explicit TestAllocator(AllocatorState* state) noexcept
+        : state{state}
+    {
+    }
+
+    template <typename U>
+    TestAllocator(const TestAllocator<U>& other) noexcept
+        : state{other.state}
+    {
+    }
+
+    [[nodiscard]] T* allocate(UInt64 count)
+    {
+        state->liveBytes += static_cast<Int64>(count * sizeof(T));
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    void deallocate(T* ptr, UInt64 count) noexcept
+    {
+        state->liveBytes -= static_cast<Int64>(count * sizeof(T));
+        std::allocator<T>{}.deallocate(ptr, count);
+    }
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const TestAllocator<U>& other) const noexcept
+    {
+        return state == other.state;
+    }
+
+    AllocatorState* state;
+};
+
+// Counts live instances, constructing from ThrowValue throws
+struct Tracked
+{
+    static constexpr Int32 ThrowValue = -1;
+    static inline Int64 live          = 0;
+
+    explicit Tracked(Int32 value)
+        : value{value}
+    {
+        if (value == ThrowValue) throw std::runtime_error("Tracked");
+        live++;
+    }
+
+    Tracked(const Tracked& other)
+        : value{other.value}
+    {
+        live++;
+    }
+
+    Tracked(Tracked&& other) noexcept
+        : value{std::exchange(other.value, 0)}
+    {
+        live++;
+    }
+
+    Tracked& operator=(const Tracked&) = default;
+
+    Tracked& operator=(Tracked&& other) noexcept
+    {
+        value = std::exchange(other.value, 0);
+        return *this;
+    }
+
+    ~Tracked() { live--; }
+
+    Int32 value;
+};
+
+using TrackedArray = SmallArray<Tracked, 4, TestAllocator<Tracked>>;
+
+[[nodiscard]] bool HoldsRange(const TrackedArray& values, Int32 first, Int32 count)
+{
+    if (values.Size() != static_cast<UInt64>(count)) return false;
+    for (Int32 i = 0; i < count; i++)
+        if (values[static_cast<UInt64>(i)].value != first + i) return false;
+    return true;
+}
+
+void Fill(TrackedArray& values, Int32 first, Int32 count)
+{
+    for (Int32 i = 0; i < count; i++) values.EmplaceBack(first + i);
+}
+
+void TestSpill()
+{
+    AllocatorState state;
+    {
+        TrackedArray values{TrackedArray::allocator_type(&state)};
+        Fill(values, 0, 4);
+        TEZ_CHECK(values.IsInline() && values.Capacity() == 4);
+        TEZ_CHECK(state.liveBytes == 0);
+
+        // The argument lives in the buffer that is about to be replaced
+        values.PushBack(values[0]);
+        TEZ_CHECK(!values.IsInline() && values.Capacity() == 8);
+        TEZ_CHECK(state.liveBytes == static_cast<Int64>(8 * sizeof(Tracked)));
+        TEZ_CHECK(values.Back().value == 0);
+        TEZ_CHECK(Tracked::live == 5);
+
+        values.Reserve(20);
+        TEZ_CHECK(values.Capacity() == 20);
+        TEZ_CHECK(state.liveBytes == static_cast<Int64>(20 * sizeof(Tracked)));
+        TEZ_CHECK(values.Size() == 5 && values[3].value == 3 && values[4].value == 0);
+    }
+    TEZ_CHECK(state.liveBytes == 0);
+    TEZ_CHECK(Tracked::live == 0);
+}
+
+void TestCopyAndMove()
+{
+    AllocatorState state;
+    AllocatorState otherState;
+    const TrackedArray::allocator_type allocator(&state);
+    {
+        TrackedArray inlineValues{allocator};
+        Fill(inlineValues, 0, 3);
+        TrackedArray heapValues{allocator};
+        Fill(heapValues, 10, 6);
+
+        const TrackedArray inlineCopy = inlineValues;
+        const TrackedArray heapCopy   = heapValues;
+        TEZ_CHECK(inlineCopy.IsInline() && HoldsRange(inlineCopy, 0, 3));
+        TEZ_CHECK(!heapCopy.IsInline() && HoldsRange(heapCopy, 10, 6));
+        TEZ_CHECK(heapCopy.Data() != heapValues.Data());
+
+        // Heap memory is adopted, inline elements are moved one by one
+        const Tracked* heapData = heapValues.Data();
+        TrackedArray movedHeap  = std::move(heapValues);
+        TEZ_CHECK(movedHeap.Data() == heapData && HoldsRange(movedHeap, 10, 6));
+        TEZ_CHECK(heapValues.IsEmpty() && heapValues.IsInline());
+
+        TrackedArray movedInline = std::move(inlineValues);
+        TEZ_CHECK(movedInline.IsInline() && HoldsRange(movedInline, 0, 3));
+        TEZ_CHECK(inlineValues.IsEmpty());
+
+        // Heap target, inline source: the target gives its memory back
+        TrackedArray target{allocator};
+        Fill(target, 20, 7);
+        target = std::move(movedInline);
+        TEZ_CHECK(target.IsInline() && HoldsRange(target, 0, 3));
+
+        // Inline target, heap source
+        target = std::move(movedHeap);
+        TEZ_CHECK(!target.IsInline() && target.Data() == heapData && HoldsRange(target, 10, 6));
+
+        // Another allocator can't adopt the heap memory
+        TrackedArray foreign{TrackedArray::allocator_type(&otherState)};
+        foreign = std::move(target);
+        TEZ_CHECK(foreign.Data() != heapData && HoldsRange(foreign, 10, 6));
+        TEZ_CHECK(target.IsEmpty());
+        TEZ_CHECK(otherState.liveBytes > 0);
+
+        // Copy assignment in both directions
+        target = heapCopy;
+        TEZ_CHECK(HoldsRange(target, 10, 6));
+        target = inlineCopy;
+        TEZ_CHECK(HoldsRange(target, 0, 3));
+        const TrackedArray& self = target;
+        target                   = self;
+        TEZ_CHECK(HoldsRange(target, 0, 3));
+    }
+    TEZ_CHECK(state.liveBytes == 0);
+    TEZ_CHECK(otherState.liveBytes == 0);
+    TEZ_CHECK(Tracked::live == 0);
+}
+
+void TestEmplaceAndPop()
+{
+    SmallArray<std::string, 2> values;
+    values.EmplaceBack("b");
+    values.Emplace(values.Begin(), "a");
+    values.Emplace(values.End(), "d");
+    values.Emplace(values.Begin() + 2, 3, 'c');
+    TEZ_CHECK(values.Size() == 4 && !values.IsInline());
+    TEZ_CHECK(values[0] == "a" && values[1] == "b" && values[2] == "ccc" && values[3] == "d");
+
+    TEZ_CHECK(values.PopBack() == "d");
+    TEZ_CHECK(values.PopBack() == "ccc");
+    TEZ_CHECK(values.PopBack() == "b");
+    TEZ_CHECK(values.PopBack() == "a");
+    TEZ_CHECK(!values.PopBack().has_value());
+
+    // A popped null pointer reads as empty
+    Int32 target = 0;
+    SmallArray<Int32*, 2> pointers{&target, nullptr};
+    TEZ_CHECK(!pointers.PopBack().has_value());
+    TEZ_CHECK(pointers.PopBack() == &target);
+}
+
+// A throwing constructor while spilling must neither leak the new buffer nor touch the elements
+void TestEmplaceThrows()
+{
+    AllocatorState state;
+    {
+        TrackedArray values{TrackedArray::allocator_type(&state)};
+        Fill(values, 0, 4);
+
+        bool threw = false;
+        try
+        {
+            values.EmplaceBack(Tracked::ThrowValue);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+
+        TEZ_CHECK(threw);
+        TEZ_CHECK(state.liveBytes == 0);
+        TEZ_CHECK(values.IsInline() && HoldsRange(values, 0, 4));
+        TEZ_CHECK(Tracked::live == 4);
+
+        Fill(values, 4, 1);
+        TEZ_CHECK(!values.IsInline() && HoldsRange(values, 0, 5));
+    }
+    TEZ_CHECK(state.liveBytes == 0);
+    TEZ_CHECK(Tracked::live == 0);
+}
+
+// Catches the assert StaticArray logs when it drops an element
+class RecordingChannel : public ILogChannel
+{
+public:
+    void OnLogReceived(const LogEntry& log) override
+    {
+        if (log.logType == LogType::ASSERT) asserts.emplace_back(log.message);
+    }
+
+    std::vector<std::string> asserts{};
+};
+
+void TestStaticArrayOverflow()
+{
+    RecordingChannel* channel = LogSystem::GetInstance().GetChannel<RecordingChannel>();
+    if (!TEZ_CHECK(channel)) return;
+
+    StaticArray<Tracked, 3> values;
+    for (Int32 i = 0; i < 3; i++) values.EmplaceBack(i);
+    TEZ_CHECK(values.IsFull());
+
+    values.EmplaceBack(3);
+    values.PushBack(Tracked(4));
+    TEZ_CHECK(values.Emplace(values.Begin(), 5) == values.End());
+
+    TEZ_CHECK(values.Size() == 3);
+    TEZ_CHECK(values[0].value == 0 && values[1].value == 1 && values[2].value == 2);
+    TEZ_CHECK(Tracked::live == 3);
+    TEZ_CHECK(channel->asserts.size() == 3);
+    for (const std::string& message : channel->asserts)
+        TEZ_CHECK(message == std::string_view("StaticArray is full!"));
+
+    TEZ_CHECK(values.PopBack()->value == 2);
+    values.EmplaceBack(6);
+    TEZ_CHECK(values.IsFull() && values.Back().value == 6);
+    TEZ_CHECK(channel->asserts.size() == 3);
+
+    values.Clear();
+    TEZ_CHECK(Tracked::live == 0);
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+    LogSystem::GetInstance().AddChannel<RecordingChannel>();
+
+    TestSpill();
+    TestCopyAndMove();
+    TestEmplaceAndPop();
+    TestEmplaceThrows();
+    TestStaticArrayOverflow();
+
+    return Tests::Result();
+}
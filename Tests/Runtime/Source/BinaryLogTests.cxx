@@ -0,0 +1,157 @@
+#include <Tez/Core/BinaryLog.hxx>
+#include <Tez/Core/Log.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Logs through TEZ_LOGF_* and remembers what std::format makes of the same call
+#define TEZ_LOGF_EXPECT(level, formatString, ...)                              \
+    do                                                                        \
+    {                                                                         \
+        TEZ_LOGF_##level(formatString, __VA_ARGS__);                          \
+        expected.push_back({#level, std::format(formatString, __VA_ARGS__)}); \
+    } while (0)
+
+namespace Tez
+{
+namespace
+{
+struct ExpectedEntry
+{
+    std::string level{};
+    std::string message{};
+};
+
+std::vector<ExpectedEntry> expected;
+
+// Checks that TEZ_LOGF_* still reaches channels next to the BinaryLogChannel
+class RecordingChannel : public ILogChannel
+{
+public:
+    void OnLogReceived(const LogEntry& log) override { messages.emplace_back(log.message); }
+
+    std::vector<std::string> messages{};
+};
+
+void LogTextExpect(const std::string& message)
+{
+    LogSystem::GetInstance().Log(message, LogType::WARNING);
+    expected.push_back({"WARNING", message});
+}
+
+void LogMixedArguments()
+{
+    const Int32 negative         = -42;
+    const UInt64 large           = Limits<UInt64>::max;
+    const Float32 single         = 0.1f;
+    const Float64 precise        = 3.14159265358979;
+    const char* cString          = "c string";
+    const std::string string     = "std::string";
+    const std::string_view view  = "string view";
+    const void* pointer          = &negative;
+    const Int16 small            = 7;
+    const UInt8 byte             = 200;
+    const Float64 negativeDouble = -1234.5;
+
+    TEZ_LOGF_EXPECT(INFO, "ints {} {} {} {}", negative, large, small, byte);
+    TEZ_LOGF_EXPECT(INFO, "hex {:x} {:#010x} {:+d} {:>6}|", large, 255u, 17, negative);
+    TEZ_LOGF_EXPECT(INFO, "floats {} {} {} {}", single, precise, negativeDouble, 1.0);
+    TEZ_LOGF_EXPECT(INFO, "float specs {:.3f} {:08.2f} {:e} {:g}", precise, negativeDouble,
+                    12345.678, single);
+    TEZ_LOGF_EXPECT(WARNING, "bools {} {} {:d}", true, false, true);
+    TEZ_LOGF_EXPECT(WARNING, "chars {} {:d} {:>3}", 'x', 'A', 'z');
+    TEZ_LOGF_EXPECT(ERROR, "strings {} {} {} {:>12}|{:<5}|", cString, string, view, "right",
+                    "ab");
+    TEZ_LOGF_EXPECT(ERROR, "pointer {}", pointer);
+    TEZ_LOGF_EXPECT(INFO, "escaped {{}} {}", 1);
+
+    // Shortest round trip form, scientific whenever it is shorter than fixed
+    const Float32 smallSingle = 0.0001f;
+    TEZ_LOGF_EXPECT(INFO, "shortest {} {} {} {} {} {}", 100000.0, smallSingle, 1e-5, 1e20, 0.5,
+                    -0.0);
+    TEZ_LOGF_EXPECT(INFO, "shortest single {} {} {}", static_cast<Float32>(123456.0f),
+                    static_cast<Float32>(1e10f), static_cast<Float32>(3.4e38f));
+    // A precision without a type is general formatting
+    TEZ_LOGF_EXPECT(INFO, "general {:.3} {:.3} {:.1} {:#.3} {:+08.3} {:.3}", 1.0, 1234.5678,
+                    100000.0, 1.0, 3.14159, smallSingle);
+    TEZ_LOGF_EXPECT(INFO, "alternate {:#e} {:#.0f} {:#.3}", 1.0, 3.0, 2.0);
+
+    // Enough records to span several chunks, with plain Log() text in between that has to
+    // decode in the same order
+    for (Int32 i = 0; i < 2000; i++)
+    {
+        TEZ_LOGF_EXPECT(INFO, "loop {} {} {}", i, static_cast<Float64>(i) * 0.25, i % 3 == 0);
+        if (i % 100 == 0) LogTextExpect(std::format("text {}", i));
+    }
+}
+
+[[nodiscard]] std::vector<std::string> ReadLines(const std::filesystem::path& path)
+{
+    std::vector<std::string> lines;
+    std::ifstream file(path);
+    for (std::string line; std::getline(file, line);) lines.push_back(line);
+    return lines;
+}
+
+// Decoded lines look like "[<time>] [<level>] <message>"
+void CheckDecoded(const std::vector<std::string>& decoded)
+{
+    TEZ_CHECK(decoded.size() == expected.size());
+    for (UInt64 i = 0; i < std::min(decoded.size(), expected.size()); i++)
+    {
+        const std::string prefix = std::format("] [{}] ", expected[i].level);
+        const UInt64 start       = decoded[i].find(prefix);
+        const bool matches       = start != std::string::npos &&
+                             decoded[i].substr(start + prefix.size()) == expected[i].message;
+        if (!TEZ_CHECK(matches))
+            std::fprintf(stderr, "  decoded:  %s\n  expected: %s\n", decoded[i].c_str(),
+                         expected[i].message.c_str());
+    }
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path logPath   = directory / "tez-binary-log-tests.tezlog";
+    const std::filesystem::path textPath  = directory / "tez-binary-log-tests.txt";
+
+    LogSystem& logSystem = LogSystem::GetInstance();
+    // Small chunks so records land in several of them
+    logSystem.AddChannel<BinaryLogChannel>(logPath.string(), BinaryLogChannel::FileHeaderSize);
+    logSystem.AddChannel<RecordingChannel>();
+
+    LogMixedArguments();
+
+    // The other channels now get the text through the queue
+    logSystem.StartAsync();
+    LogMixedArguments();
+    logSystem.Shutdown();
+
+    BinaryLogChannel* binaryChannel = logSystem.GetChannel<BinaryLogChannel>();
+    RecordingChannel* recording     = logSystem.GetChannel<RecordingChannel>();
+    if (!TEZ_CHECK(binaryChannel && binaryChannel->IsOpen() && recording)) return Tests::Result();
+    binaryChannel->Flush();
+    TEZ_CHECK(binaryChannel->GetDroppedCount() == 0);
+
+    TEZ_CHECK(recording->messages.size() == expected.size());
+    for (UInt64 i = 0; i < std::min(recording->messages.size(), expected.size()); i++)
+        TEZ_CHECK(recording->messages[i] == expected[i].message);
+
+    const std::string command = std::format(R"("{}" "{}" "{}" "{}")", TEZ_PYTHON_EXECUTABLE,
+                                            TEZ_DECODE_BINARY_LOG_SCRIPT, logPath.string(),
+                                            textPath.string());
+    if (TEZ_CHECK(std::system(command.c_str()) == 0)) CheckDecoded(ReadLines(textPath));
+
+    std::filesystem::remove(textPath);
+    return Tests::Result();
+}
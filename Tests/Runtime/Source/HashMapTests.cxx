@@ -0,0 +1,424 @@
+#include <Tez/Core/HashMap.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+struct AllocatorState
+{
+    UInt64 liveBytes{0};
+    UInt64 allocations{0};
+    // Only byte arrays are control arrays, everything else is slots
+    bool failSlots{false};
+};
+
+// Counts what the table holds and fails the slot half of a rehash on request
+template <typename T>
+class TestAllocator
+{
+public:
+    using value_type = T;
+
+    explicit TestAllocator(AllocatorState* state) noexcept
+        : state{state}
+    {
+    }
+
+    template <typename U>
+    TestAllocator(const TestAllocator<U>& other) noexcept
+        : state{other.state}
+    {
+    }
+
+    [[nodiscard]] T* allocate(UInt64 count)
+    {
+        if (state->failSlots && sizeof(T) != 1) throw std::bad_alloc();
+        state->liveBytes += count * sizeof(T);
+        state->allocations++;
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    void deallocate(T* ptr, UInt64 count) noexcept
+    {
+        state->liveBytes -= count * sizeof(T);
+        std::allocator<T>{}.deallocate(ptr, count);
+    }
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const TestAllocator<U>& other) const noexcept
+    {
+        return state == other.state;
+    }
+
+    AllocatorState* state;
+};
+
+using Map = FlatHashMap<Int32, std::string, Hash<Int32>, std::equal_to<Int32>,
+                        TestAllocator<std::pair<Int32, std::string>>>;
+
+void TestGetAllocator()
+{
+    AllocatorState state;
+    const Map map{Map::allocator_type(&state)};
+
+    static_assert(std::is_same_v<decltype(map.GetAllocator()), Map::allocator_type>);
+    TEZ_CHECK(map.GetAllocator().state == &state);
+}
+
+[[nodiscard]] bool HoldsFirst(const Map& map, Int32 count)
+{
+    if (map.Size() != static_cast<UInt64>(count)) return false;
+    for (Int32 i = 0; i < count; i++)
+    {
+        const auto it = map.Find(i);
+        if (it == map.End() || it->second != std::to_string(i)) return false;
+    }
+    return true;
+}
+
+// A failed slot allocation must neither leak the control array nor touch the table
+void TestRehashThrows()
+{
+    AllocatorState state;
+    {
+        Map map{Map::allocator_type(&state)};
+        // Filled up to the maximum load, so the next new key rehashes
+        Int32 count = 0;
+        while (map.Size() == 0 || map.Size() < map.Capacity() * 7 / 8)
+        {
+            map.Insert(count, std::to_string(count));
+            count++;
+        }
+
+        const UInt64 capacity  = map.Capacity();
+        const UInt64 liveBytes = state.liveBytes;
+        state.failSlots        = true;
+
+        bool threw = false;
+        try
+        {
+            map.Insert(count, std::to_string(count));
+        }
+        catch (const std::bad_alloc&)
+        {
+            threw = true;
+        }
+
+        state.failSlots = false;
+        TEZ_CHECK(threw);
+        TEZ_CHECK(state.liveBytes == liveBytes);
+        TEZ_CHECK(map.Capacity() == capacity);
+        TEZ_CHECK(HoldsFirst(map, count));
+
+        // Still usable once the allocator recovers
+        map.Insert(count, std::to_string(count));
+        TEZ_CHECK(map.Capacity() > capacity);
+        TEZ_CHECK(HoldsFirst(map, count + 1));
+    }
+    TEZ_CHECK(state.liveBytes == 0);
+}
+
+// Starts every key in the first window and takes the control byte from other bits, so probes
+// run across several windows and erasing from them has to leave tombstones
+struct ClusteredHash
+{
+    [[nodiscard]] UInt64 operator()(Int32 key) const noexcept
+    {
+        const UInt64 value = static_cast<UInt64>(key);
+        return ((value % 3) << 7) | ((value * 0x9e3779b97f4a7c15) >> 57);
+    }
+};
+
+// Key k starts probing at slot k, so consecutive keys fill consecutive slots
+struct SequentialHash
+{
+    [[nodiscard]] UInt64 operator()(Int32 key) const noexcept
+    {
+        return static_cast<UInt64>(key) << 7;
+    }
+};
+
+[[nodiscard]] Int32 KeyOf(const std::pair<const Int32, std::string>& entry) { return entry.first; }
+[[nodiscard]] Int32 KeyOf(const std::pair<Int32, std::string>& entry) { return entry.first; }
+[[nodiscard]] Int32 KeyOf(Int32 key) { return key; }
+
+[[nodiscard]] bool HoldsEntry(const std::unordered_map<Int32, std::string>& reference,
+                              const std::pair<Int32, std::string>& entry)
+{
+    const auto it = reference.find(entry.first);
+    return it != reference.end() && it->second == entry.second;
+}
+
+[[nodiscard]] bool HoldsEntry(const std::unordered_set<Int32>& reference, Int32 key)
+{
+    return reference.contains(key);
+}
+
+// Counts the differences between table and reference, iterating both the whole table and
+// from every iterator Find returns
+template <typename Table, typename Reference>
+[[nodiscard]] UInt64 CountMismatches(const Table& table, const Reference& reference)
+{
+    UInt64 mismatches = table.Size() == reference.size() ? 0 : 1;
+
+    std::vector<Int32> order;
+    for (const auto& entry : table)
+    {
+        if (!HoldsEntry(reference, entry)) mismatches++;
+        order.push_back(KeyOf(entry));
+    }
+    if (order.size() != reference.size()) mismatches++;
+
+    std::vector<Int32> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) mismatches++;
+
+    // Find hands out iterators that haven't scanned their window, ++ must still land on the
+    // entry that follows in table order
+    for (UInt64 i = 0; i < order.size(); i++)
+    {
+        auto it = table.Find(order[i]);
+        if (it == table.End())
+        {
+            mismatches++;
+            continue;
+        }
+
+        const auto previous = it++;
+        if (KeyOf(*previous) != order[i]) mismatches++;
+        if (i + 1 < order.size() ? it == table.End() || KeyOf(*it) != order[i + 1]
+                                 : it != table.End())
+            mismatches++;
+    }
+
+    // A few full walks from Find, the iterator has to stay valid across windows
+    for (UInt64 i = 0; i < order.size(); i += std::max<UInt64>(order.size() / 4, 1))
+    {
+        UInt64 position = i;
+        for (auto it = table.Find(order[i]); it != table.End(); ++it, position++)
+            if (position >= order.size() || KeyOf(*it) != order[position]) mismatches++;
+        if (position != order.size()) mismatches++;
+    }
+
+    for (const auto& entry : reference)
+        if (!table.Contains(KeyOf(entry))) mismatches++;
+    return mismatches;
+}
+
+// Phases alternate between mostly inserting and mostly erasing over key ranges of different
+// sizes, taking the table through growth, tombstone buildup and in place rehashes
+struct Phase
+{
+    Int32 keyRange{0};
+    UInt32 insertPercent{0};
+};
+
+constexpr Phase Phases[] = {{64, 80},   {64, 30},   {1024, 75}, {1024, 50}, {1024, 20},
+                            {256, 60},  {4096, 85}, {4096, 50}, {4096, 10}, {16, 50},
+                            {2048, 70}, {2048, 5}};
+constexpr UInt32 OperationsPerPhase = 3000;
+
+template <typename Hasher>
+void TestMapAgainstReference(UInt64 seed)
+{
+    using TestMap = FlatHashMap<Int32, std::string, Hasher>;
+
+    TestMap map;
+    std::unordered_map<Int32, std::string> reference;
+    std::mt19937_64 random(seed);
+    UInt64 mismatches = 0;
+
+    for (const Phase& phase : Phases)
+    {
+        std::uniform_int_distribution<Int32> keys(0, phase.keyRange - 1);
+        for (UInt32 operation = 0; operation < OperationsPerPhase; operation++)
+        {
+            const Int32 key         = keys(random);
+            // Long enough to live on the heap
+            const std::string value = std::to_string(random()) + "/" + std::to_string(key);
+            const bool inserting    = random() % 100 < phase.insertPercent;
+
+            if (inserting)
+            {
+                switch (random() % 4)
+                {
+                case 0:
+                    if (map.Insert(key, value).second != reference.emplace(key, value).second)
+                        mismatches++;
+                    break;
+                case 1:
+                    if (map.InsertOrAssign(key, value).second !=
+                        reference.insert_or_assign(key, value).second)
+                        mismatches++;
+                    break;
+                case 2:
+                    map[key]       = value;
+                    reference[key] = value;
+                    break;
+                default:
+                {
+                    const auto [it, inserted] = map.TryEmplace(key, value);
+                    if (inserted != reference.try_emplace(key, value).second) mismatches++;
+                    if (it->first != key || it->second != reference[key]) mismatches++;
+                    break;
+                }
+                }
+            }
+            else if (random() % 2)
+            {
+                if (map.Erase(key) != (reference.erase(key) == 1)) mismatches++;
+            }
+            else
+            {
+                const auto it = map.Find(key);
+                if ((it != map.End()) != reference.contains(key)) mismatches++;
+                if (it != map.End())
+                {
+                    map.Erase(it);
+                    reference.erase(key);
+                }
+            }
+
+            if (operation % 500 == 0) mismatches += CountMismatches(map, reference);
+        }
+
+        mismatches += CountMismatches(map, reference);
+        const TestMap copy = map;
+        mismatches += CountMismatches(copy, reference);
+    }
+
+    TEZ_CHECK(mismatches == 0);
+}
+
+template <typename Hasher>
+void TestSetAgainstReference(UInt64 seed)
+{
+    FlatHashSet<Int32, Hasher> set;
+    std::unordered_set<Int32> reference;
+    std::mt19937_64 random(seed);
+    UInt64 mismatches = 0;
+
+    for (const Phase& phase : Phases)
+    {
+        std::uniform_int_distribution<Int32> keys(0, phase.keyRange - 1);
+        for (UInt32 operation = 0; operation < OperationsPerPhase; operation++)
+        {
+            const Int32 key = keys(random);
+            if (random() % 100 < phase.insertPercent)
+            {
+                const auto [it, inserted] = set.Insert(key);
+                if (inserted != reference.insert(key).second || *it != key) mismatches++;
+            }
+            else if (random() % 2)
+            {
+                if (set.Erase(key) != (reference.erase(key) == 1)) mismatches++;
+            }
+            else
+            {
+                const auto it = set.Find(key);
+                if ((it != set.End()) != reference.contains(key)) mismatches++;
+                if (it != set.End())
+                {
+                    set.Erase(it);
+                    reference.erase(key);
+                }
+            }
+
+            if (operation % 500 == 0) mismatches += CountMismatches(set, reference);
+        }
+        mismatches += CountMismatches(set, reference);
+    }
+
+    set.Clear();
+    reference.clear();
+    mismatches += CountMismatches(set, reference);
+    TEZ_CHECK(mismatches == 0);
+}
+
+using SequentialMap = FlatHashMap<Int32, std::string, SequentialHash, std::equal_to<Int32>,
+                                  TestAllocator<std::pair<Int32, std::string>>>;
+
+[[nodiscard]] bool HoldsRange(const SequentialMap& map, Int32 first, Int32 count)
+{
+    if (map.Size() != static_cast<UInt64>(count)) return false;
+    for (Int32 key = first; key < first + count; key++)
+    {
+        const auto it = map.Find(key);
+        if (it == map.End() || it->second != std::to_string(key)) return false;
+    }
+    return true;
+}
+
+// Erasing from the middle of a run of full slots leaves tombstones, once they use up the growth
+// budget the table rehashes at its current capacity since it is mostly empty
+void TestTombstoneRehash()
+{
+    AllocatorState state;
+    {
+        SequentialMap map{SequentialMap::allocator_type(&state)};
+        map.Reserve(64);
+        const UInt64 capacity = map.Capacity();
+
+        // Half the maximum load, so a full growth budget leaves room for an in place rehash
+        const Int32 live = static_cast<Int32>(capacity * 7 / 16);
+        for (Int32 key = 0; key < live; key++) map.Insert(key, std::to_string(key));
+
+        // A window of live keys sliding over the slots, tombstones trail behind it
+        UInt64 allocations = state.allocations;
+        UInt64 rehashes    = 0;
+        for (Int32 first = 0; first < static_cast<Int32>(capacity) * 8; first++)
+        {
+            map.Erase(first);
+            map.Insert(first + live, std::to_string(first + live));
+            if (state.allocations != allocations) rehashes++;
+            allocations = state.allocations;
+        }
+
+        TEZ_CHECK(rehashes > 0);
+        TEZ_CHECK(map.Capacity() == capacity);
+        TEZ_CHECK(HoldsRange(map, static_cast<Int32>(capacity) * 8, live));
+    }
+    TEZ_CHECK(state.liveBytes == 0);
+
+    // A lone entry has empty neighbours, erasing it leaves nothing behind to rehash away
+    {
+        Map map{Map::allocator_type(&state)};
+        map.Reserve(64);
+        const UInt64 allocations = state.allocations;
+        for (Int32 key = 0; key < 10000; key++)
+        {
+            map.Insert(key, std::to_string(key));
+            map.Erase(key);
+        }
+        TEZ_CHECK(state.allocations == allocations);
+        TEZ_CHECK(map.IsEmpty());
+    }
+    TEZ_CHECK(state.liveBytes == 0);
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+    TestGetAllocator();
+    TestRehashThrows();
+    TestTombstoneRehash();
+    TestMapAgainstReference<Hash<Int32>>(1);
+    TestMapAgainstReference<ClusteredHash>(2);
+    TestSetAgainstReference<Hash<Int32>>(3);
+    TestSetAgainstReference<ClusteredHash>(4);
+
+    return Tests::Result();
+}
@@ -0,0 +1,335 @@
+#include <Tez/Core/JobSystem.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+constexpr UInt32 Rounds = 8;
+
+// Every job bumps its own counter, each one has to end up at exactly 1
+class RunCounter
+{
+public:
+    explicit RunCounter(UInt64 count)
+        : _count{count}
+        , _runs{std::make_unique<std::atomic<UInt32>[]>(count)}
+    {
+    }
+
+    void Run(UInt64 id) noexcept { _runs[id].fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] bool HasRun(UInt64 id) const noexcept
+    {
+        return _runs[id].load(std::memory_order_relaxed) != 0;
+    }
+
+    void CheckRanOnce() const
+    {
+        UInt64 wrong = 0;
+        for (UInt64 i = 0; i < _count; i++)
+            if (_runs[i].load(std::memory_order_relaxed) != 1) wrong++;
+        TEZ_CHECK(wrong == 0);
+    }
+
+private:
+    UInt64 _count;
+    std::unique_ptr<std::atomic<UInt32>[]> _runs;
+};
+
+// Each link depends on the previous one, so it must see it done
+void TestChains(JobSystem& jobs)
+{
+    constexpr UInt64 ChainCount  = 32;
+    constexpr UInt64 ChainLength = 64;
+
+    RunCounter counter(ChainCount * ChainLength);
+    std::atomic<UInt64> outOfOrder{0};
+
+    std::vector<JobHandle> tails;
+    for (UInt64 chain = 0; chain < ChainCount; chain++)
+    {
+        JobHandle previous;
+        for (UInt64 link = 0; link < ChainLength; link++)
+        {
+            const UInt64 id = chain * ChainLength + link;
+            const auto run  = [&, id, link]
+            {
+                if (link > 0 && !counter.HasRun(id - 1))
+                    outOfOrder.fetch_add(1, std::memory_order_relaxed);
+                counter.Run(id);
+            };
+            previous = jobs.Then(previous, run);
+        }
+        tails.push_back(std::move(previous));
+    }
+
+    for (const JobHandle& tail : tails) jobs.Wait(tail);
+    counter.CheckRanOnce();
+    TEZ_CHECK(outOfOrder.load() == 0);
+}
+
+// top -> every side -> bottom, the bottom also depends on a job that already finished
+void TestDiamonds(JobSystem& jobs)
+{
+    constexpr UInt64 DiamondCount   = 256;
+    constexpr UInt64 SideCount      = 6;
+    constexpr UInt64 JobsPerDiamond = SideCount + 2;
+
+    RunCounter counter(DiamondCount * JobsPerDiamond);
+    std::atomic<UInt64> outOfOrder{0};
+
+    const JobHandle finished = jobs.Schedule([] {});
+    jobs.Wait(finished);
+
+    std::vector<JobHandle> bottoms;
+    for (UInt64 diamond = 0; diamond < DiamondCount; diamond++)
+    {
+        const UInt64 top = diamond * JobsPerDiamond;
+        JobHandle topJob = jobs.Schedule([&, top] { counter.Run(top); });
+
+        std::vector<JobHandle> sides{finished};
+        for (UInt64 side = 1; side <= SideCount; side++)
+        {
+            sides.push_back(jobs.Then(topJob,
+                                      [&, top, side]
+                                      {
+                                          if (!counter.HasRun(top))
+                                              outOfOrder.fetch_add(1, std::memory_order_relaxed);
+                                          counter.Run(top + side);
+                                      }));
+        }
+
+        bottoms.push_back(jobs.Schedule(
+            [&, top]
+            {
+                for (UInt64 side = 1; side <= SideCount; side++)
+                    if (!counter.HasRun(top + side))
+                        outOfOrder.fetch_add(1, std::memory_order_relaxed);
+                counter.Run(top + SideCount + 1);
+            },
+            sides));
+    }
+
+    for (const JobHandle& bottom : bottoms) jobs.Wait(bottom);
+    counter.CheckRanOnce();
+    TEZ_CHECK(outOfOrder.load() == 0);
+}
+
+// Threads that aren't workers go through the injected queue and wait without a deque
+void TestForeignThreads(JobSystem& jobs)
+{
+    constexpr UInt32 ThreadCount   = 4;
+    constexpr UInt64 JobsPerThread = 512;
+
+    RunCounter counter(ThreadCount * JobsPerThread);
+    std::atomic<UInt64> outOfOrder{0};
+
+    std::vector<std::thread> threads;
+    for (UInt32 t = 0; t < ThreadCount; t++)
+    {
+        threads.emplace_back(
+            [&, t]
+            {
+                std::vector<JobHandle> handles;
+                for (UInt64 i = 0; i < JobsPerThread; i++)
+                {
+                    const UInt64 id = t * JobsPerThread + i;
+                    // Every other job depends on the one scheduled before it
+                    if (i % 2 == 0)
+                    {
+                        handles.push_back(jobs.Schedule([&, id] { counter.Run(id); }));
+                        continue;
+                    }
+
+                    const auto run = [&, id]
+                    {
+                        if (!counter.HasRun(id - 1))
+                            outOfOrder.fetch_add(1, std::memory_order_relaxed);
+                        counter.Run(id);
+                    };
+                    handles.push_back(jobs.Then(handles.back(), run));
+                }
+                for (const JobHandle& handle : handles) jobs.Wait(handle);
+            });
+    }
+
+    for (std::thread& thread : threads) thread.join();
+    counter.CheckRanOnce();
+    TEZ_CHECK(outOfOrder.load() == 0);
+}
+
+// Jobs that fan out again and wait for it, the waiting worker has to keep running other jobs
+void TestNestedParallelFor(JobSystem& jobs)
+{
+    constexpr UInt64 OuterCount = 32;
+    constexpr UInt64 InnerCount = 257;
+
+    RunCounter counter(OuterCount * InnerCount);
+
+    std::vector<JobHandle> handles;
+    for (UInt64 outer = 0; outer < OuterCount; outer++)
+    {
+        handles.push_back(jobs.Schedule(
+            [&, outer]
+            {
+                ParallelFor(jobs, InnerCount,
+                            [&, outer](UInt64 inner) { counter.Run(outer * InnerCount + inner); },
+                            1 + outer % 8);
+            }));
+    }
+
+    for (const JobHandle& handle : handles) jobs.Wait(handle);
+    counter.CheckRanOnce();
+}
+
+// Wait called from inside a job on a child and on a job from another tree
+void TestWaitInsideJob(JobSystem& jobs)
+{
+    constexpr UInt64 ParentCount = 128;
+
+    // Parents, then children, then the shared job
+    RunCounter counter(ParentCount * 2 + 1);
+    std::atomic<UInt64> notDone{0};
+
+    const JobHandle shared = jobs.Schedule([&] { counter.Run(ParentCount * 2); });
+
+    std::vector<JobHandle> parents;
+    for (UInt64 parent = 0; parent < ParentCount; parent++)
+    {
+        parents.push_back(jobs.Schedule(
+            [&, parent]
+            {
+                const JobHandle child = jobs.Schedule([&, parent]
+                                                      { counter.Run(ParentCount + parent); });
+                jobs.Wait(child);
+                jobs.Wait(shared);
+                if (!child.IsDone() || !counter.HasRun(ParentCount + parent))
+                    notDone.fetch_add(1, std::memory_order_relaxed);
+                counter.Run(parent);
+            }));
+    }
+
+    for (const JobHandle& parent : parents) jobs.Wait(parent);
+    counter.CheckRanOnce();
+    TEZ_CHECK(notDone.load() == 0);
+}
+
+// bool partials used to go through std::vector<bool>
+void TestReduceBool(JobSystem& jobs)
+{
+    constexpr UInt64 Count = 10000;
+
+    std::vector<UInt32> values(Count);
+    for (UInt64 i = 0; i < Count; i++) values[i] = static_cast<UInt32>(i * 2);
+
+    const auto allEven = [&](UInt64 skip)
+    {
+        return ParallelReduce(
+            jobs, Count, true,
+            [&](bool partial, UInt64 i) { return partial && (i == skip || values[i] % 2 == 0); },
+            [](bool left, bool right) { return left && right; });
+    };
+
+    TEZ_CHECK(allEven(Count));
+    values[Count / 3] = 1;
+    TEZ_CHECK(!allEven(Count));
+    TEZ_CHECK(allEven(Count / 3));
+
+    // A grain size that leaves a shorter last chunk
+    const UInt64 sum = ParallelReduce(
+        jobs, Count, UInt64{0}, [](UInt64 partial, UInt64 i) { return partial + i; },
+        [](UInt64 left, UInt64 right) { return left + right; }, 7);
+    TEZ_CHECK(sum == Count * (Count - 1) / 2);
+}
+
+// A throwing job still counts as done and releases its dependents
+void TestThrowingJob()
+{
+    // No worker threads, so only Wait() on this thread runs the jobs
+    JobSystem jobs(1);
+    std::atomic<bool> continued{false};
+    const JobHandle failing = jobs.Schedule([] { throw std::runtime_error("Job"); });
+    const JobHandle next    = jobs.Then(failing, [&] { continued.store(true); });
+
+    bool threw = false;
+    try
+    {
+        jobs.Wait(failing);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+
+    TEZ_CHECK(threw);
+    TEZ_CHECK(failing.IsDone());
+    jobs.Wait(next);
+    TEZ_CHECK(continued.load());
+}
+
+constexpr UInt32 LeftoverCount = 8;
+std::atomic<UInt32> leftoversRun{0};
+
+// Destroyed after the static JobSystem, which runs whatever is still queued on the exiting main
+// thread once its thread_locals are gone
+struct LeftoverCheck
+{
+    ~LeftoverCheck()
+    {
+        if (leftoversRun.load() == LeftoverCount) return;
+        std::fprintf(stderr, "%u of %u leftover jobs ran\n", leftoversRun.load(), LeftoverCount);
+        std::_Exit(EXIT_FAILURE);
+    }
+};
+
+// Left for the static instance to finish, each job releases and allocates jobs while it runs
+void ScheduleLeftovers()
+{
+    // Constructed before the instance, so destroyed after it
+    static LeftoverCheck check;
+    JobSystem& jobs = JobSystem::GetInstance();
+
+    JobHandle previous;
+    for (UInt32 i = 0; i < LeftoverCount / 2; i++)
+    {
+        previous = jobs.Then(previous,
+                             [&jobs]
+                             {
+                                 leftoversRun.fetch_add(1);
+                                 jobs.Schedule([] { leftoversRun.fetch_add(1); });
+                             });
+    }
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+    // More workers than cores on small machines so stealing still happens
+    JobSystem jobs(std::max(std::thread::hardware_concurrency(), 4u));
+
+    for (UInt32 round = 0; round < Rounds; round++)
+    {
+        TestChains(jobs);
+        TestDiamonds(jobs);
+        TestForeignThreads(jobs);
+        TestNestedParallelFor(jobs);
+        TestWaitInsideJob(jobs);
+        TestReduceBool(jobs);
+    }
+    TestThrowingJob();
+    ScheduleLeftovers();
+
+    return Tests::Result();
+}
@@ -0,0 +1,152 @@
+#include <Tez/Core/Log.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+constexpr UInt64 MessagesPerProducer = 20000;
+// Small enough that DROP and OVERWRITE actually run out of slots
+constexpr UInt32 BufferSize = 64;
+
+// "<producer> <index> <payload>", the payload and its length depend on both numbers so a torn
+// message can't pass for another one
+void MakeMessage(std::string& message, UInt32 producer, UInt64 index)
+{
+    message.clear();
+    std::format_to(std::back_inserter(message), "{} {} ", producer, index);
+
+    const UInt64 payloadLength = 16 + (producer * 31 + index * 7) % 200;
+    for (UInt64 i = 0; i < payloadLength; i++)
+        message.push_back(static_cast<Char>('a' + (producer + index + i) % 26));
+}
+
+[[nodiscard]] bool ParseMessage(std::string_view message, UInt32& producer, UInt64& index)
+{
+    const Char* end                  = message.data() + message.size();
+    const auto [next, producerError] = std::from_chars(message.data(), end, producer);
+    if (producerError != std::errc{} || next == end || *next != ' ') return false;
+
+    return std::from_chars(next + 1, end, index).ec == std::errc{};
+}
+
+// Written by the drain thread only, read once Flush() returned
+struct Delivery
+{
+    std::vector<UInt64> counts{};
+    std::vector<UInt64> nextIndex{};
+    UInt64 torn{0};
+    UInt64 reordered{0};
+    std::string expected{};
+};
+
+Delivery delivery;
+
+class CheckingChannel : public ILogChannel
+{
+public:
+    void OnLogReceived(const LogEntry& log) override
+    {
+        UInt32 producer = 0;
+        UInt64 index    = 0;
+        if (!ParseMessage(log.message, producer, index) || producer >= delivery.counts.size() ||
+            index >= MessagesPerProducer || log.logType != LogType::INFO)
+        {
+            delivery.torn++;
+            return;
+        }
+
+        MakeMessage(delivery.expected, producer, index);
+        if (log.message != delivery.expected)
+        {
+            delivery.torn++;
+            return;
+        }
+
+        // Every policy keeps the order of one producer, dropped entries only leave gaps
+        if (index < delivery.nextIndex[producer]) delivery.reordered++;
+        delivery.nextIndex[producer] = index + 1;
+        delivery.counts[producer]++;
+    }
+};
+
+void TestOverflowPolicy(LogOverflowPolicy policy, UInt32 producerCount)
+{
+    delivery = {.counts    = std::vector<UInt64>(producerCount, 0),
+                .nextIndex = std::vector<UInt64>(producerCount, 0)};
+
+    LogSystem& logSystem = LogSystem::GetInstance();
+    logSystem.StartAsync(BufferSize, policy);
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+    for (UInt32 p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back(
+            [&, p]
+            {
+                std::string message;
+                while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+
+                for (UInt64 i = 0; i < MessagesPerProducer; i++)
+                {
+                    MakeMessage(message, p, i);
+                    logSystem.Log(message, LogType::INFO);
+                }
+            });
+    }
+
+    start.store(true, std::memory_order_release);
+    for (std::thread& producer : producers) producer.join();
+    logSystem.Flush();
+
+    UInt64 delivered = 0;
+    for (const UInt64 count : delivery.counts) delivered += count;
+    const UInt64 produced = MessagesPerProducer * producerCount;
+    const UInt64 dropped  = logSystem.GetDroppedCount();
+
+    std::printf("policy %d, %u producers: %llu delivered, %llu dropped\n",
+                static_cast<int>(policy), producerCount,
+                static_cast<unsigned long long>(delivered),
+                static_cast<unsigned long long>(dropped));
+
+    TEZ_CHECK(delivery.torn == 0);
+    TEZ_CHECK(delivery.reordered == 0);
+    TEZ_CHECK(delivered + dropped == produced);
+
+    if (policy == LogOverflowPolicy::BLOCK)
+    {
+        TEZ_CHECK(dropped == 0);
+        for (const UInt64 count : delivery.counts) TEZ_CHECK(count == MessagesPerProducer);
+    }
+
+    // Restarts with the same buffer size every time, which reuses the slots
+    logSystem.Shutdown();
+    TEZ_CHECK(!logSystem.IsAsync());
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+    LogSystem::GetInstance().AddChannel<CheckingChannel>();
+
+    const UInt32 producerCount = std::max(std::thread::hardware_concurrency(), 8u);
+    for (const LogOverflowPolicy policy :
+         {LogOverflowPolicy::BLOCK, LogOverflowPolicy::DROP, LogOverflowPolicy::OVERWRITE})
+        TestOverflowPolicy(policy, producerCount);
+
+    return Tests::Result();
+}
@@ -0,0 +1,301 @@
+#include <Tez/Core/Array.hxx>
+#include <Tez/Core/FrameAllocator.hxx>
+#include <Tez/Core/LinearAllocator.hxx>
+#include <Tez/Core/PoolAllocator.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+constexpr UInt64 Capacity = 4096;
+
+void TestLinearDeallocate()
+{
+    LinearAllocator allocator(Capacity);
+
+    void* first  = allocator.Allocate(64);
+    void* second = allocator.Allocate(128);
+    TEZ_CHECK(first && second);
+
+    // Freeing only updates the stats, the memory comes back with Rewind or Reset
+    const UInt64 remaining = allocator.GetRemaining();
+    allocator.Deallocate(second, 128);
+    TEZ_CHECK(allocator.GetRemaining() == remaining);
+    TEZ_CHECK(allocator.GetStats().bytesInUse == 64);
+    TEZ_CHECK(allocator.GetStats().allocationCount == 1);
+
+    // Frees after Reset belong to memory that is already reclaimed
+    allocator.Reset();
+    allocator.Deallocate(first, 64);
+    TEZ_CHECK(allocator.GetStats().bytesInUse == 0);
+    TEZ_CHECK(allocator.GetStats().allocationCount == 0);
+    TEZ_CHECK(allocator.GetRemaining() == Capacity);
+}
+
+void TestLinearRewind()
+{
+    LinearAllocator allocator(Capacity);
+
+    void* kept = allocator.Allocate(32);
+    TEZ_CHECK(kept);
+    const LinearAllocator::Marker marker = allocator.GetMarker();
+
+    void* rewound = allocator.Allocate(256);
+    allocator.Rewind(marker);
+    allocator.Deallocate(rewound, 256);
+
+    const AllocatorStats stats = allocator.GetStats();
+    TEZ_CHECK(stats.bytesInUse == 32);
+    TEZ_CHECK(stats.allocationCount == 1);
+    TEZ_CHECK(allocator.GetRemaining() == Capacity - marker.offset);
+}
+
+void TestLinearStaleFreeOfReusedMemory()
+{
+    LinearAllocator allocator(Capacity);
+
+    void* stale = allocator.Allocate(16);
+    allocator.Reset();
+    void* reused = allocator.Allocate(16);
+    TEZ_CHECK(stale == reused);
+
+    // Indistinguishable from a real free the first time, the second must not wrap. Neither may
+    // hand reused out again.
+    allocator.Deallocate(stale, 16);
+    allocator.Deallocate(stale, 16);
+    TEZ_CHECK(allocator.GetStats().bytesInUse == 0);
+    TEZ_CHECK(allocator.GetStats().allocationCount == 0);
+
+    void* next = allocator.Allocate(16);
+    TEZ_CHECK(next && next != reused);
+}
+
+// Sizes close to the UInt64 limit must fail instead of wrapping around the capacity check
+void TestLinearOverflow()
+{
+    LinearAllocator allocator(Capacity);
+
+    void* first = allocator.Allocate(64);
+    TEZ_CHECK(first);
+    TEZ_CHECK(!allocator.Allocate(Limits<UInt64>::max));
+    TEZ_CHECK(!allocator.Allocate(Limits<UInt64>::max - 32));
+    TEZ_CHECK(!allocator.Allocate(Capacity, 8));
+    TEZ_CHECK(allocator.GetStats().allocationCount == 1);
+
+    // Exactly the rest still fits
+    TEZ_CHECK(allocator.Allocate(allocator.GetRemaining(), 1));
+    TEZ_CHECK(allocator.GetRemaining() == 0);
+}
+
+void TestPmrContainerOutlivingReset()
+{
+    LinearAllocator allocator(Capacity);
+    {
+        std::pmr::vector<UInt64> values(&allocator);
+        for (UInt64 i = 0; i < 64; i++) values.push_back(i);
+        allocator.Reset();
+    }
+
+    const AllocatorStats stats = allocator.GetStats();
+    TEZ_CHECK(stats.bytesInUse == 0);
+    TEZ_CHECK(stats.allocationCount == 0);
+    TEZ_CHECK(stats.bytesInUse <= stats.peakBytesInUse);
+}
+
+void TestFramePeak()
+{
+    FrameAllocator allocator(Capacity);
+
+    void* first  = allocator.Allocate(100);
+    void* second = allocator.Allocate(200);
+    TEZ_CHECK(first && second);
+    allocator.Deallocate(second, 200);
+    allocator.NextFrame();
+    TEZ_CHECK(allocator.GetStats().peakBytesInUse == 300);
+
+    // Both frames count while the previous one is alive
+    void* third = allocator.Allocate(50);
+    TEZ_CHECK(third);
+    TEZ_CHECK(allocator.GetStats().bytesInUse == 150);
+    TEZ_CHECK(allocator.GetStats().peakBytesInUse == 300);
+
+    // first is freed two frames after its allocation, when its buffer was already reset
+    allocator.NextFrame();
+    allocator.Deallocate(first, 100);
+    const AllocatorStats stats = allocator.GetStats();
+    TEZ_CHECK(stats.bytesInUse == 50);
+    TEZ_CHECK(stats.allocationCount == 1);
+}
+
+using FrameArray = DynamicArray<UInt64, ResourceAllocator<UInt64, FrameAllocator>>;
+
+// Every growth allocates a new buffer and frees the old one, which stays committed until reset
+void TestFrameArrayGrowth()
+{
+    FrameAllocator allocator(16 * Capacity);
+    {
+        FrameArray values{FrameArray::allocator_type(allocator)};
+        static_assert(std::is_same_v<decltype(values.GetAllocator()), FrameArray::allocator_type>);
+        TEZ_CHECK(&values.GetAllocator().GetResource() == &allocator);
+
+        for (UInt64 i = 0; i < 1000; i++) values.PushBack(i);
+
+        bool ordered = true;
+        for (UInt64 i = 0; i < values.Size(); i++) ordered = ordered && values[i] == i;
+        TEZ_CHECK(values.Size() == 1000 && ordered);
+
+        const AllocatorStats stats = allocator.GetStats();
+        TEZ_CHECK(stats.allocationCount == 1);
+        TEZ_CHECK(stats.totalAllocations > 1);
+        TEZ_CHECK(stats.bytesInUse >= 1000 * sizeof(UInt64));
+        TEZ_CHECK(stats.bytesCommitted > stats.bytesInUse);
+        TEZ_CHECK(stats.peakBytesInUse > stats.bytesInUse);
+        TEZ_CHECK(stats.Fragmentation() > 0.0);
+    }
+
+    TEZ_CHECK(allocator.GetStats().bytesInUse == 0);
+    TEZ_CHECK(allocator.GetStats().allocationCount == 0);
+
+    allocator.NextFrame();
+    allocator.NextFrame();
+    TEZ_CHECK(allocator.GetStats().bytesCommitted == 0);
+}
+
+// An exhausted frame throws through the allocator and leaves the array as it was
+void TestFrameArrayExhausted()
+{
+    FrameAllocator allocator(Capacity);
+    FrameArray values{FrameArray::allocator_type(allocator)};
+
+    bool threw = false;
+    try
+    {
+        for (UInt64 i = 0; i < Capacity; i++) values.PushBack(i);
+    }
+    catch (const std::bad_alloc&)
+    {
+        threw = true;
+    }
+
+    bool ordered = true;
+    for (UInt64 i = 0; i < values.Size(); i++) ordered = ordered && values[i] == i;
+    TEZ_CHECK(threw);
+    TEZ_CHECK(values.Size() > 0 && ordered);
+}
+
+void TestPoolReuse()
+{
+    constexpr UInt64 BlocksPerChunk = 4;
+    constexpr UInt64 Count          = 6;
+
+    PoolAllocator pool(48, BlocksPerChunk);
+    void* blocks[Count]{};
+    for (void*& block : blocks) block = pool.Allocate(40);
+
+    bool aligned = true;
+    for (void* block : blocks)
+        aligned = aligned && block &&
+                  reinterpret_cast<std::uintptr_t>(block) % pool.GetBlockAlignment() == 0;
+    TEZ_CHECK(aligned);
+
+    void* sorted[Count];
+    std::copy(std::begin(blocks), std::end(blocks), sorted);
+    std::sort(std::begin(sorted), std::end(sorted));
+    TEZ_CHECK(std::adjacent_find(std::begin(sorted), std::end(sorted)) == std::end(sorted));
+
+    AllocatorStats stats = pool.GetStats();
+    TEZ_CHECK(stats.allocationCount == Count);
+    TEZ_CHECK(stats.bytesInUse == Count * 40);
+    TEZ_CHECK(stats.bytesReserved == 2 * BlocksPerChunk * pool.GetBlockSize());
+
+    // Freed blocks come back last in, first out, without growing
+    pool.Deallocate(blocks[2], 40);
+    pool.Deallocate(blocks[4], 40);
+    TEZ_CHECK(pool.GetStats().allocationCount == Count - 2);
+    TEZ_CHECK(pool.Allocate(40) == blocks[4]);
+    TEZ_CHECK(pool.Allocate(48) == blocks[2]);
+    TEZ_CHECK(pool.GetStats().bytesReserved == stats.bytesReserved);
+
+    // Bigger or more aligned than a block goes upstream and is counted separately
+    void* big       = pool.Allocate(pool.GetBlockSize() + 1);
+    void* aligned64 = pool.Allocate(16, 64);
+    TEZ_CHECK(big && aligned64);
+    TEZ_CHECK(reinterpret_cast<std::uintptr_t>(aligned64) % 64 == 0);
+    TEZ_CHECK(pool.GetStats().allocationCount == Count + 2);
+    pool.Deallocate(big, pool.GetBlockSize() + 1);
+    pool.Deallocate(aligned64, 16, 64);
+
+    pool.Deallocate(blocks[2], 48);
+    for (UInt64 i = 0; i < Count; i++)
+        if (i != 2) pool.Deallocate(blocks[i], 40);
+
+    stats = pool.GetStats();
+    TEZ_CHECK(stats.bytesInUse == 0);
+    TEZ_CHECK(stats.allocationCount == 0);
+    TEZ_CHECK(stats.totalAllocations == Count + 4);
+}
+
+// One pool per thread and power of two size class
+void TestPoolThreadLocal()
+{
+    PoolAllocator& pool = PoolAllocator::GetThreadLocal(24);
+    TEZ_CHECK(pool.GetBlockSize() == 32);
+    TEZ_CHECK(&PoolAllocator::GetThreadLocal(32) == &pool);
+    TEZ_CHECK(&PoolAllocator::GetThreadLocal(33) != &pool);
+    TEZ_CHECK(PoolAllocator::GetThreadLocal(1).GetBlockSize() == sizeof(void*));
+    constexpr UInt64 MaxBlockSize = PoolAllocator::MaxThreadLocalBlockSize;
+    TEZ_CHECK(PoolAllocator::GetThreadLocal(MaxBlockSize).GetBlockSize() == MaxBlockSize);
+
+    void* first = pool.Allocate(24);
+    pool.Deallocate(first, 24);
+    TEZ_CHECK(pool.Allocate(24) == first);
+
+    bool sharedWithMain = true;
+    bool reused         = false;
+    std::thread thread(
+        [&]
+        {
+            PoolAllocator& own = PoolAllocator::GetThreadLocal(24);
+            sharedWithMain     = &own == &pool;
+
+            void* block = own.Allocate(24);
+            own.Deallocate(block, 24);
+            reused = own.Allocate(24) == block;
+            own.Deallocate(block, 24);
+        });
+    thread.join();
+    TEZ_CHECK(!sharedWithMain);
+    TEZ_CHECK(reused);
+
+    pool.Deallocate(first, 24);
+    TEZ_CHECK(pool.GetStats().allocationCount == 0);
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+    TestLinearDeallocate();
+    TestLinearRewind();
+    TestLinearStaleFreeOfReusedMemory();
+    TestLinearOverflow();
+    TestPmrContainerOutlivingReset();
+    TestFramePeak();
+    TestFrameArrayGrowth();
+    TestFrameArrayExhausted();
+    TestPoolReuse();
+    TestPoolThreadLocal();
+
+    return Tests::Result();
+}
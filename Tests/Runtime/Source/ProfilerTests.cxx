@@ -0,0 +1,499 @@
+#include <Tez/Core/Profiler.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Tez
+{
+namespace
+{
+constinit ProfileZone testZone{"Test zone", __FILE__, __LINE__};
+constinit ProfileZone sharedZone{"Shared zone", __FILE__, __LINE__};
+// Another site with the same name, aggregated with sharedZone
+constinit ProfileZone sharedZoneCopy{"Shared zone", __FILE__, __LINE__};
+constinit ProfileZone escapedZone{"Quote \" back\\slash\ttab", "Dir\\File \"x\".cxx", 7};
+constinit ProfileZone longZone{"A zone name well past the forty eight columns of the report table",
+                               __FILE__, __LINE__};
+
+// Recorded ticks only matter relative to each other
+constexpr UInt64 BaseTicks = 1000;
+
+// Drops everything recorded so far, pending events included
+void ResetProfiler()
+{
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.Collect();
+    profiler.Clear();
+}
+
+[[nodiscard]] const ProfileZoneStats* FindStats(const DynamicArray<ProfileZoneStats>& summary,
+                                                std::string_view name)
+{
+    for (const ProfileZoneStats& zone : summary)
+        if (zone.name == name) return &zone;
+    return nullptr;
+}
+
+[[nodiscard]] bool IsNear(Float64 value, Float64 expected, Float64 tolerance)
+{
+    return std::abs(value - expected) <= std::abs(expected) * tolerance;
+}
+
+// Durations 1..count ticks, recorded longest first so the summary has to sort them
+void RecordDurations(const ProfileZone& zone, UInt64 count, UInt64 scale = 1)
+{
+    for (UInt64 duration = count; duration > 0; duration--)
+        Profiler::Record(zone, BaseTicks, BaseTicks + duration * scale);
+}
+
+void TestSummary()
+{
+    ResetProfiler();
+    Profiler& profiler = Profiler::GetInstance();
+
+    RecordDurations(testZone, 150);
+    RecordDurations(sharedZone, 100);
+    RecordDurations(sharedZoneCopy, 100);
+    Profiler::Record(escapedZone, BaseTicks, BaseTicks + 5);
+
+    // Every value is a tick count times the same factor, min being one tick
+    const DynamicArray<ProfileZoneStats> summary = profiler.GetSummary();
+    TEZ_CHECK(summary.Size() == 3);
+
+    const ProfileZoneStats* test = FindStats(summary, testZone.name);
+    if (TEZ_CHECK(test))
+    {
+        const Float64 tick = test->min;
+        TEZ_CHECK(tick > 0.0);
+        TEZ_CHECK(test->count == 150);
+        TEZ_CHECK(test->total == 150.0 * 151.0 / 2.0 * tick);
+        TEZ_CHECK(test->max == 150.0 * tick);
+        // Rank ceil(0.99 * 150) = 149
+        TEZ_CHECK(test->p99 == 149.0 * tick);
+    }
+
+    const ProfileZoneStats* shared = FindStats(summary, sharedZone.name);
+    if (TEZ_CHECK(shared))
+    {
+        // Each duration twice, rank ceil(0.99 * 200) = 198 holds the second 99
+        const Float64 tick = shared->min;
+        TEZ_CHECK(shared->count == 200);
+        TEZ_CHECK(shared->total == 2.0 * 100.0 * 101.0 / 2.0 * tick);
+        TEZ_CHECK(shared->max == 100.0 * tick);
+        TEZ_CHECK(shared->p99 == 99.0 * tick);
+    }
+
+    const ProfileZoneStats* single = FindStats(summary, escapedZone.name);
+    if (TEZ_CHECK(single))
+    {
+        TEZ_CHECK(single->count == 1);
+        TEZ_CHECK(single->min == single->max && single->p99 == single->max);
+        TEZ_CHECK(single->total == single->max);
+    }
+
+    // Largest total first
+    TEZ_CHECK(std::is_sorted(summary.Begin(), summary.End(),
+                             [](const ProfileZoneStats& lhs, const ProfileZoneStats& rhs)
+                             { return lhs.total > rhs.total; }));
+
+    // Clear() forgets them
+    profiler.Clear();
+    TEZ_CHECK(profiler.GetSummary().IsEmpty());
+}
+
+// Just enough JSON for the trace file
+struct JsonValue
+{
+    enum class Kind
+    {
+        NONE,
+        BOOL,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+
+    [[nodiscard]] const JsonValue* Get(const std::string& key) const
+    {
+        const auto it = object.find(key);
+        return it != object.end() ? it->second.get() : nullptr;
+    }
+
+    Kind kind{Kind::NONE};
+    bool boolean{false};
+    Float64 number{0.0};
+    std::string string{};
+    std::vector<JsonValue> array{};
+    std::map<std::string, std::unique_ptr<JsonValue>> object{};
+};
+
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string_view text)
+        : _text{text}
+    {
+    }
+
+    // False when anything but whitespace follows the value or the text is malformed
+    [[nodiscard]] bool Parse(JsonValue& value)
+    {
+        if (!ParseValue(value)) return false;
+        SkipSpace();
+        return _pos == _text.size();
+    }
+
+private:
+    void SkipSpace()
+    {
+        while (_pos < _text.size() && std::string_view(" \t\r\n").contains(_text[_pos])) _pos++;
+    }
+
+    [[nodiscard]] bool Consume(Char c)
+    {
+        SkipSpace();
+        if (_pos >= _text.size() || _text[_pos] != c) return false;
+        _pos++;
+        return true;
+    }
+
+    [[nodiscard]] bool ParseLiteral(std::string_view literal)
+    {
+        if (_text.substr(_pos, literal.size()) != literal) return false;
+        _pos += literal.size();
+        return true;
+    }
+
+    [[nodiscard]] bool ParseString(std::string& out)
+    {
+        if (!Consume('"')) return false;
+        while (_pos < _text.size())
+        {
+            const Char c = _text[_pos++];
+            if (c == '"') return true;
+            if (static_cast<UInt8>(c) < 0x20) return false;
+            if (c != '\\')
+            {
+                out.push_back(c);
+                continue;
+            }
+
+            if (_pos >= _text.size()) return false;
+            const Char escaped = _text[_pos++];
+            switch (escaped)
+            {
+            case '"':
+            case '\\':
+            case '/': out.push_back(escaped); break;
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'u':
+            {
+                // Only the control characters the writer escapes
+                if (_pos + 4 > _text.size()) return false;
+                const UInt32 code = std::stoul(std::string(_text.substr(_pos, 4)), nullptr, 16);
+                if (code >= 0x80) return false;
+                out.push_back(static_cast<Char>(code));
+                _pos += 4;
+                break;
+            }
+            default: return false;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool ParseValue(JsonValue& value)
+    {
+        SkipSpace();
+        if (_pos >= _text.size()) return false;
+
+        const Char c = _text[_pos];
+        if (c == '"')
+        {
+            value.kind = JsonValue::Kind::STRING;
+            return ParseString(value.string);
+        }
+        if (c == '[')
+        {
+            value.kind = JsonValue::Kind::ARRAY;
+            _pos++;
+            if (Consume(']')) return true;
+            do
+            {
+                if (!ParseValue(value.array.emplace_back())) return false;
+            } while (Consume(','));
+            return Consume(']');
+        }
+        if (c == '{')
+        {
+            value.kind = JsonValue::Kind::OBJECT;
+            _pos++;
+            if (Consume('}')) return true;
+            do
+            {
+                std::string key;
+                if (!ParseString(key) || !Consume(':')) return false;
+                auto member = std::make_unique<JsonValue>();
+                if (!ParseValue(*member)) return false;
+                if (!value.object.emplace(std::move(key), std::move(member)).second) return false;
+            } while (Consume(','));
+            return Consume('}');
+        }
+        if (c == 't' || c == 'f')
+        {
+            value.kind    = JsonValue::Kind::BOOL;
+            value.boolean = c == 't';
+            return ParseLiteral(value.boolean ? "true" : "false");
+        }
+        if (c == 'n')
+        {
+            value.kind = JsonValue::Kind::NONE;
+            return ParseLiteral("null");
+        }
+
+        const UInt64 start = _pos;
+        while (_pos < _text.size() &&
+               std::string_view("+-.0123456789eE").contains(_text[_pos]))
+            _pos++;
+        if (_pos == start) return false;
+        value.kind = JsonValue::Kind::NUMBER;
+        UInt64 used  = 0;
+        value.number = std::stod(std::string(_text.substr(start, _pos - start)), &used);
+        return used == _pos - start;
+    }
+
+    std::string_view _text;
+    UInt64 _pos{0};
+};
+
+[[nodiscard]] bool IsString(const JsonValue* value, std::string_view expected)
+{
+    return value && value->kind == JsonValue::Kind::STRING && value->string == expected;
+}
+
+[[nodiscard]] bool IsNumber(const JsonValue* value)
+{
+    return value && value->kind == JsonValue::Kind::NUMBER;
+}
+
+void TestChromeTrace()
+{
+    ResetProfiler();
+    Profiler& profiler = Profiler::GetInstance();
+
+    const std::string threadName = "Main \"thread\" \\ one";
+    profiler.SetThreadName(threadName);
+
+    constexpr UInt64 ShortTicks = 1'000'000;
+    Profiler::Record(escapedZone, BaseTicks, BaseTicks + ShortTicks);
+    Profiler::Record(testZone, BaseTicks + ShortTicks, BaseTicks + 3 * ShortTicks);
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "tez-profiler-tests.json";
+    if (!TEZ_CHECK(profiler.WriteChromeTrace(path.string()))) return;
+
+    std::string text;
+    {
+        std::ifstream file(path);
+        text.assign(std::istreambuf_iterator<Char>(file), std::istreambuf_iterator<Char>());
+    }
+    std::filesystem::remove(path);
+
+    JsonValue trace;
+    if (!TEZ_CHECK(JsonParser(text).Parse(trace))) return;
+    TEZ_CHECK(IsString(trace.Get("displayTimeUnit"), "ns"));
+
+    const JsonValue* events = trace.Get("traceEvents");
+    if (!TEZ_CHECK(events && events->kind == JsonValue::Kind::ARRAY)) return;
+
+    const JsonValue* escaped = nullptr;
+    const JsonValue* test    = nullptr;
+    std::vector<Float64> namedThreads;
+    for (const JsonValue& event : events->array)
+    {
+        const JsonValue* phase = event.Get("ph");
+        const JsonValue* tid   = event.Get("tid");
+        if (!TEZ_CHECK(phase && IsNumber(tid))) continue;
+
+        if (phase->string == "M")
+        {
+            const JsonValue* args = event.Get("args");
+            TEZ_CHECK(IsString(event.Get("name"), "thread_name"));
+            if (TEZ_CHECK(args) && IsString(args->Get("name"), threadName))
+                namedThreads.push_back(tid->number);
+        }
+        else if (TEZ_CHECK(phase->string == "X"))
+        {
+            if (IsString(event.Get("name"), escapedZone.name)) escaped = &event;
+            if (IsString(event.Get("name"), testZone.name)) test = &event;
+        }
+    }
+    if (!TEZ_CHECK(escaped && test)) return;
+
+    // Both on this thread, which carries the name
+    TEZ_CHECK(escaped->Get("tid")->number == test->Get("tid")->number);
+    TEZ_CHECK(std::ranges::count(namedThreads, test->Get("tid")->number) == 1);
+
+    const JsonValue* args = escaped->Get("args");
+    if (TEZ_CHECK(args))
+    {
+        TEZ_CHECK(IsString(args->Get("file"), escapedZone.file));
+        TEZ_CHECK(IsNumber(args->Get("line")) && args->Get("line")->number == escapedZone.line);
+    }
+    TEZ_CHECK(IsString(escaped->Get("cat"), "tez"));
+
+    // The second zone is twice as long and starts where the first one ends
+    const JsonValue* escapedTs  = escaped->Get("ts");
+    const JsonValue* escapedDur = escaped->Get("dur");
+    const JsonValue* testTs     = test->Get("ts");
+    const JsonValue* testDur    = test->Get("dur");
+    if (TEZ_CHECK(IsNumber(escapedTs) && IsNumber(escapedDur) && IsNumber(testTs) &&
+                  IsNumber(testDur)))
+    {
+        TEZ_CHECK(escapedDur->number > 0.0);
+        TEZ_CHECK(IsNear(testDur->number, 2.0 * escapedDur->number, 1e-3));
+        TEZ_CHECK(IsNear(testTs->number - escapedTs->number, escapedDur->number, 1e-3));
+    }
+}
+
+// Keeps every entry it receives
+class RecordingChannel : public ILogChannel
+{
+public:
+    void OnLogReceived(const LogEntry& log) override
+    {
+        lines.emplace_back(log.message);
+        logTypes.push_back(log.logType);
+    }
+
+    std::vector<std::string> lines{};
+    std::vector<LogType> logTypes{};
+};
+
+// Zone name, then count, total (ms), min, max and p99 (us)
+struct ReportRow
+{
+    std::string name{};
+    UInt64 count{0};
+    Float64 values[4]{};
+};
+
+[[nodiscard]] bool ParseRow(const std::string& line, ReportRow& row)
+{
+    if (line.size() <= 48) return false;
+    row.name = line.substr(0, 48);
+    row.name.erase(row.name.find_last_not_of(' ') + 1);
+
+    std::istringstream stream(line.substr(48));
+    stream >> row.count;
+    for (Float64& value : row.values) stream >> value;
+    return !stream.fail() && (stream >> std::ws).eof();
+}
+
+void TestReport()
+{
+    ResetProfiler();
+    Profiler& profiler = Profiler::GetInstance();
+
+    // Long enough to print with several significant digits
+    constexpr UInt64 Scale = 100'000;
+    RecordDurations(testZone, 10, Scale);
+    RecordDurations(longZone, 3, Scale);
+
+    RecordingChannel channel;
+    profiler.Report(channel, LogType::WARNING);
+    const DynamicArray<ProfileZoneStats> summary = profiler.GetSummary();
+
+    if (!TEZ_CHECK(channel.lines.size() == 3)) return;
+    TEZ_CHECK(std::ranges::all_of(channel.logTypes,
+                                  [](LogType logType) { return logType == LogType::WARNING; }));
+
+    std::istringstream header(channel.lines[0]);
+    std::vector<std::string> words{std::istream_iterator<std::string>(header),
+                                   std::istream_iterator<std::string>()};
+    const std::vector<std::string> columns{"Zone", "Count", "Total", "(ms)", "Min",
+                                           "(us)", "Max",   "(us)",  "p99",  "(us)"};
+    TEZ_CHECK(words == columns);
+
+    // Same order as the summary, names cut at the column width
+    for (UInt64 i = 0; i < summary.Size(); i++)
+    {
+        const ProfileZoneStats& zone = summary[i];
+        ReportRow row;
+        if (!TEZ_CHECK(ParseRow(channel.lines[i + 1], row))) continue;
+
+        TEZ_CHECK(row.name == zone.name.substr(0, 48));
+        TEZ_CHECK(row.count == zone.count);
+        TEZ_CHECK(IsNear(row.values[0], zone.total / 1e6, 1e-2));
+        TEZ_CHECK(IsNear(row.values[1], zone.min / 1e3, 1e-2));
+        TEZ_CHECK(IsNear(row.values[2], zone.max / 1e3, 1e-2));
+        TEZ_CHECK(IsNear(row.values[3], zone.p99 / 1e3, 1e-2));
+    }
+    TEZ_CHECK(summary.Size() == 2 && summary[0].name == testZone.name);
+    TEZ_CHECK(longZone.name != std::string_view(longZone.name).substr(0, 48));
+}
+
+// Collects from its destructor, which frees the buffer of its already retired thread, then
+// opens a zone on that thread
+struct LateZone
+{
+    ~LateZone()
+    {
+        Profiler::GetInstance().Collect();
+        ProfileScope scope(testZone);
+    }
+
+    bool used{false};
+};
+
+thread_local LateZone lateZone{};
+
+// Zones opened after the thread's buffer was retired are dropped instead of writing into it
+void TestZoneAfterThreadExit()
+{
+    Profiler& profiler = Profiler::GetInstance();
+    profiler.Clear();
+
+    std::thread thread(
+        []
+        {
+            // Constructed before the profiler's guard, so destroyed after it
+            lateZone.used = true;
+            ProfileScope scope(testZone);
+        });
+    thread.join();
+
+    UInt64 count = 0;
+    for (const ProfileZoneStats& zone : profiler.GetSummary())
+        if (zone.name == testZone.name) count = zone.count;
+    TEZ_CHECK(count == 1);
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+    TestSummary();
+    TestChromeTrace();
+    TestReport();
+    TestZoneAfterThreadExit();
+
+    return Tests::Result();
+}
@@ -0,0 +1,171 @@
+#include <Tez/Core/TypeRegistry.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Fails the allocation this many allocations from now, negative never fails
+Tez::Int64 allocationsUntilFailure = -1;
+}
+
+void* operator new(std::size_t size)
+{
+    if (allocationsUntilFailure == 0)
+    {
+        allocationsUntilFailure = -1;
+        throw std::bad_alloc();
+    }
+    if (allocationsUntilFailure > 0) allocationsUntilFailure--;
+
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace Tez
+{
+namespace
+{
+struct Component
+{
+    explicit Component(UInt32 id)
+        : id{id}
+    {
+    }
+
+    virtual ~Component() = default;
+
+    UInt32 id;
+};
+
+template <UInt32 N>
+struct Numbered : Component
+{
+    Numbered()
+        : Component{N}
+    {
+    }
+};
+
+using Registry = TypeRegistry<Component>;
+
+// The ids in iteration order
+[[nodiscard]] std::vector<UInt32> Order(const Registry& registry)
+{
+    std::vector<UInt32> ids;
+    for (const auto& entry : registry) ids.push_back(entry->id);
+    return ids;
+}
+
+template <UInt32 N>
+[[nodiscard]] bool Holds(const Registry& registry)
+{
+    const Numbered<N>* component = registry.Get<Numbered<N>>();
+    return component && component->id == N && registry.Contains<Numbered<N>>() &&
+           registry.Get(TypeID<Numbered<N>>()) == component;
+}
+
+void TestOrder()
+{
+    Registry registry;
+    Numbered<0>* first = registry.Emplace<Numbered<0>>();
+    registry.Emplace<Numbered<1>>();
+    registry.Emplace<Numbered<2>>();
+    registry.Emplace<Numbered<3>>();
+    TEZ_CHECK(first && registry.Get<Numbered<0>>() == first);
+    TEZ_CHECK(Order(registry) == std::vector<UInt32>({0, 1, 2, 3}));
+
+    // A second instance of a type is refused
+    TEZ_CHECK(!registry.Emplace<Numbered<1>>());
+    TEZ_CHECK(registry.Size() == 4);
+
+    // Entries behind a removed one move down, their lookups follow
+    TEZ_CHECK(registry.Remove<Numbered<1>>());
+    TEZ_CHECK(Order(registry) == std::vector<UInt32>({0, 2, 3}));
+    TEZ_CHECK(!registry.Contains<Numbered<1>>() && !registry.Get<Numbered<1>>());
+    TEZ_CHECK(Holds<0>(registry) && Holds<2>(registry) && Holds<3>(registry));
+
+    TEZ_CHECK(!registry.Remove<Numbered<1>>());
+    TEZ_CHECK(registry.Remove<Numbered<0>>());
+    TEZ_CHECK(registry.Remove<Numbered<3>>());
+    TEZ_CHECK(Order(registry) == std::vector<UInt32>({2}));
+    TEZ_CHECK(Holds<2>(registry));
+
+    // Registered again, it goes to the back
+    registry.Emplace<Numbered<0>>();
+    registry.Emplace<Numbered<1>>();
+    TEZ_CHECK(Order(registry) == std::vector<UInt32>({2, 0, 1}));
+    TEZ_CHECK(Holds<0>(registry) && Holds<1>(registry) && Holds<2>(registry));
+
+    registry.Clear();
+    TEZ_CHECK(registry.IsEmpty() && !registry.Get<Numbered<2>>());
+}
+
+// Enough types for the index to rehash, removing every third one renumbers entries on both
+// sides of each removal
+template <UInt32... N>
+void TestManyTypes(std::integer_sequence<UInt32, N...>)
+{
+    Registry registry;
+    (registry.Emplace<Numbered<N>>(), ...);
+    TEZ_CHECK(Order(registry) == std::vector<UInt32>({N...}));
+
+    ((N % 3 == 1 ? static_cast<void>(registry.Remove<Numbered<N>>()) : static_cast<void>(0)),
+     ...);
+
+    std::vector<UInt32> expected;
+    ((N % 3 != 1 ? expected.push_back(N) : static_cast<void>(0)), ...);
+    TEZ_CHECK(Order(registry) == expected);
+    TEZ_CHECK(((N % 3 == 1 ? !registry.Contains<Numbered<N>>() : Holds<N>(registry)) && ...));
+}
+
+// Failing each allocation of an Emplace in turn, it either registers the type or leaves the
+// registry as it was. The first Emplace also allocates the index.
+void TestEmplaceThrows()
+{
+    Registry registry;
+
+    bool emplaced = false;
+    for (Int64 failAt = 0; !emplaced; failAt++)
+    {
+        allocationsUntilFailure = failAt;
+        try
+        {
+            emplaced = registry.Emplace<Numbered<0>>() != nullptr;
+        }
+        catch (const std::bad_alloc&)
+        {
+        }
+        allocationsUntilFailure = -1;
+
+        if (!emplaced) TEZ_CHECK(registry.IsEmpty() && !registry.Contains<Numbered<0>>());
+    }
+
+    TEZ_CHECK(Order(registry) == std::vector<UInt32>({0}));
+    TEZ_CHECK(Holds<0>(registry));
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+    TestOrder();
+    TestManyTypes(std::make_integer_sequence<UInt32, 40>());
+    TestEmplaceThrows();
+
+    return Tests::Result();
+}
@@ -0,0 +1,318 @@
+#include <Tez/Core/VectorStream.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+// Built once per SIMD configuration (scalar, SSE, AVX2), see Tests/CMakeLists.txt. Every kernel
+// has to match the per element Vector3/Vector4 operation bit for bit, over the whole packs and
+// over the scalar tail. NaNs only have to be NaN on both sides.
+
+namespace Tez
+{
+namespace
+{
+// Around every pack width: empty, tail only, exact packs, packs plus a tail
+constexpr UInt64 Sizes[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 67, 130};
+
+template <typename T>
+    requires std::is_floating_point_v<T>
+[[nodiscard]] bool SameBits(T actual, T expected)
+{
+    using Bits = std::conditional_t<sizeof(T) == 4, UInt32, UInt64>;
+    if (std::isnan(actual) || std::isnan(expected))
+        return std::isnan(actual) && std::isnan(expected);
+    return std::bit_cast<Bits>(actual) == std::bit_cast<Bits>(expected);
+}
+
+template <typename V>
+    requires(!std::is_floating_point_v<V>)
+[[nodiscard]] bool SameBits(const V& actual, const V& expected)
+{
+    using Traits = VectorTraits<V>;
+    using Scalar = typename Traits::Scalar;
+
+    Scalar actualComponents[Traits::Components];
+    Scalar expectedComponents[Traits::Components];
+    Scalar* actualPointers[Traits::Components];
+    Scalar* expectedPointers[Traits::Components];
+    for (UInt32 c = 0; c < Traits::Components; c++)
+    {
+        actualPointers[c]   = &actualComponents[c];
+        expectedPointers[c] = &expectedComponents[c];
+    }
+    Traits::Store(actual, actualPointers, 0);
+    Traits::Store(expected, expectedPointers, 0);
+
+    for (UInt32 c = 0; c < Traits::Components; c++)
+        if (!SameBits(actualComponents[c], expectedComponents[c])) return false;
+    return true;
+}
+
+// Moderate magnitudes with a spread of exponents, plus signed zeros, denormals and values that
+// overflow once multiplied
+template <typename T>
+class ValueSource
+{
+public:
+    explicit ValueSource(UInt32 seed)
+        : _random{seed}
+    {
+    }
+
+    T Next()
+    {
+        static constexpr T Specials[] = {T{0},
+                                         -T{0},
+                                         T{1},
+                                         std::numeric_limits<T>::denorm_min(),
+                                         std::numeric_limits<T>::min(),
+                                         std::numeric_limits<T>::max() / T{4}};
+
+        if (std::uniform_int_distribution<UInt32>(0, 15)(_random) == 0)
+            return Specials[std::uniform_int_distribution<UInt64>(0, std::size(Specials) - 1)(
+                _random)];
+
+        const double mantissa = std::uniform_real_distribution<double>(-1.0, 1.0)(_random);
+        const int exponent    = std::uniform_int_distribution<int>(-20, 20)(_random);
+        return static_cast<T>(std::ldexp(mantissa, exponent));
+    }
+
+    template <typename V>
+    V NextVector()
+    {
+        using Traits = VectorTraits<V>;
+
+        T components[Traits::Components];
+        const T* pointers[Traits::Components];
+        for (UInt32 c = 0; c < Traits::Components; c++)
+        {
+            components[c] = Next();
+            pointers[c]   = &components[c];
+        }
+        return Traits::Load(pointers, 0);
+    }
+
+    template <typename V>
+    VectorStream<V> NextStream(UInt64 count)
+    {
+        VectorStream<V> stream;
+        for (UInt64 i = 0; i < count; i++) stream.PushBack(NextVector<V>());
+        return stream;
+    }
+
+private:
+    std::mt19937 _random;
+};
+
+template <typename V, typename Expected>
+void CheckStream(const VectorStream<V>& actual, UInt64 count, Expected&& expected)
+{
+    if (!TEZ_CHECK(actual.Size() == count)) return;
+
+    UInt64 mismatches = 0;
+    for (UInt64 i = 0; i < count; i++)
+        if (!SameBits(actual.Get(i), expected(i))) mismatches++;
+    TEZ_CHECK(mismatches == 0);
+}
+
+template <typename T, typename Allocator, typename Expected>
+void CheckScalars(const DynamicArray<T, Allocator>& actual, UInt64 count, Expected&& expected)
+{
+    if (!TEZ_CHECK(actual.Size() == count)) return;
+
+    UInt64 mismatches = 0;
+    for (UInt64 i = 0; i < count; i++)
+        if (!SameBits(actual.Data()[i], expected(i))) mismatches++;
+    TEZ_CHECK(mismatches == 0);
+}
+
+template <typename V>
+void TestKernels(UInt64 count, ValueSource<typename VectorStream<V>::Scalar>& source)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+
+    const VectorStream<V> lhs    = source.template NextStream<V>(count);
+    const VectorStream<V> rhs    = source.template NextStream<V>(count);
+    const VectorStream<V> addend = source.template NextStream<V>(count);
+    const Scalar scale           = source.Next();
+
+    // Starts out bigger than the inputs, the kernels resize it
+    VectorStream<V> out(count + 5);
+
+    Add(out, lhs, rhs);
+    CheckStream(out, count, [&](UInt64 i) { return lhs.Get(i) + rhs.Get(i); });
+
+    Subtract(out, lhs, rhs);
+    CheckStream(out, count, [&](UInt64 i) { return lhs.Get(i) - rhs.Get(i); });
+
+    MultiplyAdd(out, lhs, rhs, addend);
+    CheckStream(out, count, [&](UInt64 i) { return lhs.Get(i) * rhs.Get(i) + addend.Get(i); });
+
+    MultiplyAdd(out, lhs, scale, addend);
+    CheckStream(out, count, [&](UInt64 i) { return lhs.Get(i) * scale + addend.Get(i); });
+
+    Normalize(out, lhs);
+    CheckStream(out, count, [&](UInt64 i) { return lhs.Get(i).Normalized(); });
+
+    if constexpr (VectorStream<V>::Components == 3)
+    {
+        Cross(out, lhs, rhs);
+        CheckStream(out, count, [&](UInt64 i) { return Cross(lhs.Get(i), rhs.Get(i)); });
+    }
+
+    DynamicArray<Scalar> scalars(count + 5);
+    Dot(scalars, lhs, rhs);
+    CheckScalars(scalars, count, [&](UInt64 i) { return Dot(lhs.Get(i), rhs.Get(i)); });
+
+    Length(scalars, lhs);
+    CheckScalars(scalars, count, [&](UInt64 i) { return lhs.Get(i).Length(); });
+
+    if (count == 0) return;
+
+    // Signed zeros may come out either way depending on the reduction order, compare values
+    Scalar lowest[VectorStream<V>::Components];
+    Scalar highest[VectorStream<V>::Components];
+    const Scalar* lowPointers[VectorStream<V>::Components];
+    const Scalar* highPointers[VectorStream<V>::Components];
+    for (UInt32 c = 0; c < VectorStream<V>::Components; c++)
+    {
+        const Scalar* data = lhs.Component(c);
+        lowest[c]          = *std::min_element(data, data + count);
+        highest[c]         = *std::max_element(data, data + count);
+        lowPointers[c]     = &lowest[c];
+        highPointers[c]    = &highest[c];
+    }
+    TEZ_CHECK(Min(lhs) == VectorTraits<V>::Load(lowPointers, 0));
+    TEZ_CHECK(Max(lhs) == VectorTraits<V>::Load(highPointers, 0));
+}
+
+// The output may be either input, every lane is read before its result is stored
+template <typename V>
+void TestAliasing(UInt64 count, ValueSource<typename VectorStream<V>::Scalar>& source)
+{
+    const VectorStream<V> lhs = source.template NextStream<V>(count);
+    const VectorStream<V> rhs = source.template NextStream<V>(count);
+
+    VectorStream<V> inPlace = lhs;
+    Add(inPlace, inPlace, rhs);
+    CheckStream(inPlace, count, [&](UInt64 i) { return lhs.Get(i) + rhs.Get(i); });
+
+    inPlace = rhs;
+    Subtract(inPlace, lhs, inPlace);
+    CheckStream(inPlace, count, [&](UInt64 i) { return lhs.Get(i) - rhs.Get(i); });
+
+    inPlace = lhs;
+    MultiplyAdd(inPlace, inPlace, inPlace, rhs);
+    CheckStream(inPlace, count, [&](UInt64 i) { return lhs.Get(i) * lhs.Get(i) + rhs.Get(i); });
+
+    inPlace = lhs;
+    Normalize(inPlace, inPlace);
+    CheckStream(inPlace, count, [&](UInt64 i) { return lhs.Get(i).Normalized(); });
+
+    if constexpr (VectorStream<V>::Components == 3)
+    {
+        inPlace = lhs;
+        Cross(inPlace, inPlace, rhs);
+        CheckStream(inPlace, count, [&](UInt64 i) { return Cross(lhs.Get(i), rhs.Get(i)); });
+
+        inPlace = rhs;
+        Cross(inPlace, lhs, inPlace);
+        CheckStream(inPlace, count, [&](UInt64 i) { return Cross(lhs.Get(i), rhs.Get(i)); });
+    }
+}
+
+// Every reallocation moves the component arrays to a new stride, nothing may get lost or mixed up
+template <typename V>
+void TestStorage(ValueSource<typename VectorStream<V>::Scalar>& source)
+{
+    using Stream = VectorStream<V>;
+
+    DynamicArray<V> values;
+    Stream stream;
+    UInt64 reallocations = 0;
+    for (UInt64 i = 0; i < 3 * Stream::Granularity + 1; i++)
+    {
+        const UInt64 capacity = stream.Capacity();
+        values.PushBack(source.template NextVector<V>());
+        stream.PushBack(values.Back());
+        if (stream.Capacity() != capacity) reallocations++;
+    }
+    TEZ_CHECK(reallocations > 1);
+    TEZ_CHECK(stream.Capacity() % Stream::Granularity == 0);
+    CheckStream(stream, values.Size(), [&](UInt64 i) { return values.Data()[i]; });
+
+    stream.Reserve(stream.Capacity() * 3 + 1);
+    TEZ_CHECK(stream.Capacity() % Stream::Granularity == 0);
+    CheckStream(stream, values.Size(), [&](UInt64 i) { return values.Data()[i]; });
+
+    // Shrinking keeps the capacity, growing again has to zero what was cut off
+    const UInt64 kept = values.Size() / 2;
+    stream.Resize(kept);
+    stream.Resize(values.Size() + Stream::Granularity);
+    CheckStream(stream, stream.Size(),
+                [&](UInt64 i) { return i < kept ? values.Data()[i] : V{}; });
+
+    const Stream copy = stream;
+    CheckStream(copy, stream.Size(), [&](UInt64 i) { return stream.Get(i); });
+
+    Stream moved = std::move(stream);
+    TEZ_CHECK(stream.IsEmpty());
+    CheckStream(moved, copy.Size(), [&](UInt64 i) { return copy.Get(i); });
+
+    const Stream assigned(values);
+    CheckStream(assigned, values.Size(), [&](UInt64 i) { return values.Data()[i]; });
+    const DynamicArray<V> roundTrip = assigned.ToArray();
+    TEZ_CHECK(roundTrip.Size() == values.Size());
+    for (UInt64 i = 0; i < std::min(roundTrip.Size(), values.Size()); i++)
+        TEZ_CHECK(SameBits(roundTrip.Data()[i], values.Data()[i]));
+}
+
+template <typename V>
+void TestStream(const Char* name, UInt32 seed)
+{
+    using Scalar = typename VectorStream<V>::Scalar;
+
+    const UInt64 failuresBefore = Tests::failureCount.load(std::memory_order_relaxed);
+    ValueSource<Scalar> source(seed);
+    for (const UInt64 count : Sizes)
+    {
+        TestKernels<V>(count, source);
+        TestAliasing<V>(count, source);
+    }
+    TestStorage<V>(source);
+
+    const UInt64 failures = Tests::failureCount.load(std::memory_order_relaxed) - failuresBefore;
+    std::printf("%s: pack width %llu, %llu failed checks\n", name,
+                static_cast<unsigned long long>(Simd::Pack<Scalar>::Width),
+                static_cast<unsigned long long>(failures));
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+#if defined(TEZ_SIMD_AVX2)
+    #if defined(__GNUC__) || defined(__clang__)
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        std::printf("The CPU lacks AVX2, skipped\n");
+        return Tests::SkipExitCode;
+    }
+    #endif
+#endif
+
+    TestStream<Vector3<Float32>>("VectorStream<Vector3f32>", 1);
+    TestStream<Vector4<Float32>>("VectorStream<Vector4f32>", 2);
+    TestStream<Vector3<Float64>>("VectorStream<Vector3f64>", 3);
+    TestStream<Vector4<Float64>>("VectorStream<Vector4f64>", 4);
+
+    return Tests::Result();
+}
@@ -0,0 +1,306 @@
+#include <Tez/Core/Vector3.hxx>
+#include <Tez/Core/Vector4.hxx>
+#include <Tez/Tests/Test.hxx>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <type_traits>
+
+// Built once per SIMD configuration (scalar, SSE, AVX2), see Tests/CMakeLists.txt. Every result
+// of the Vector3f32, Vector4f32 and Vector4f64 specializations has to match the generic template
+// bit for bit, Length and Normalized included: the lane sums keep the scalar order and sqrt and
+// division are correctly rounded, so there is no room for ULP differences. NaNs only have to be
+// NaN on both sides, their payload depends on operand order.
+
+namespace Tez
+{
+namespace
+{
+// The if consteval branches, all of this has to keep compiling
+
+static_assert(-Vector3f32(1, -2, 3) == Vector3f32(-1, 2, -3));
+static_assert(Vector3f32(1, 2, 3) + Vector3f32(4, 5, 6) == Vector3f32(5, 7, 9));
+static_assert(Vector3f32(1, 2, 3) - Vector3f32(4, 5, 6) == Vector3f32(-3, -3, -3));
+static_assert(Vector3f32(1, 2, 3) * Vector3f32(4, 5, 6) == Vector3f32(4, 10, 18));
+static_assert(Float32{2} * Vector3f32(1, 2, 3) == Vector3f32(2, 4, 6));
+static_assert(Vector3f32(1, 2, 3) * Float32{2} == Vector3f32(2, 4, 6));
+static_assert(Vector3f32(2, 4, 6) / Float32{2} == Vector3f32(1, 2, 3));
+static_assert(Vector3f32(1, 2, 3) != Vector3f32(1, 2, 4));
+static_assert(Dot(Vector3f32(1, 2, 3), Vector3f32(4, 5, 6)) == 32);
+static_assert(Cross(Vector3f32(1, 0, 0), Vector3f32(0, 1, 0)) == Vector3f32(0, 0, 1));
+static_assert(Vector3f32(1, 2, 3).SquaredLength() == 14);
+static_assert([]
+              {
+                  Vector3f32 value(1, 2, 3);
+                  value += Vector3f32(1, 1, 1);
+                  value -= Vector3f32(2, 2, 2);
+                  value *= Float32{4};
+                  value /= Float32{2};
+                  return value;
+              }() == Vector3f32(0, 2, 4));
+// Only x, y and z are members, so the specialization destructures like the generic template
+static_assert([]
+              {
+                  const auto [x, y, z] = Vector3f32(1, 2, 3);
+                  return x == 1 && y == 2 && z == 3;
+              }());
+#if defined(TEZ_SIMD_SSE)
+static_assert(sizeof(Vector3f32) == 16 && alignof(Vector3f32) == 16);
+#endif
+
+static_assert(-Vector4f32(1, -2, 3, -4) == Vector4f32(-1, 2, -3, 4));
+static_assert(Vector4f32(1, 2, 3, 4) + Vector4f32(5, 6, 7, 8) == Vector4f32(6, 8, 10, 12));
+static_assert(Vector4f32(1, 2, 3, 4) - Vector4f32(5, 6, 7, 8) == Vector4f32(-4, -4, -4, -4));
+static_assert(Vector4f32(1, 2, 3, 4) * Vector4f32(5, 6, 7, 8) == Vector4f32(5, 12, 21, 32));
+static_assert(Float32{2} * Vector4f32(1, 2, 3, 4) == Vector4f32(2, 4, 6, 8));
+static_assert(Vector4f32(2, 4, 6, 8) / Float32{2} == Vector4f32(1, 2, 3, 4));
+static_assert(Vector4f32(1, 2, 3, 4) != Vector4f32(1, 2, 3, 5));
+static_assert(Dot(Vector4f32(1, 2, 3, 4), Vector4f32(5, 6, 7, 8)) == 70);
+static_assert(Vector4f32(1, 2, 3, 4).SquaredLength() == 30);
+
+static_assert(-Vector4f64(1, -2, 3, -4) == Vector4f64(-1, 2, -3, 4));
+static_assert(Vector4f64(1, 2, 3, 4) + Vector4f64(5, 6, 7, 8) == Vector4f64(6, 8, 10, 12));
+static_assert(Vector4f64(1, 2, 3, 4) - Vector4f64(5, 6, 7, 8) == Vector4f64(-4, -4, -4, -4));
+static_assert(Vector4f64(1, 2, 3, 4) * Vector4f64(5, 6, 7, 8) == Vector4f64(5, 12, 21, 32));
+static_assert(Vector4f64(1, 2, 3, 4) * Float64{2} == Vector4f64(2, 4, 6, 8));
+static_assert(Vector4f64(2, 4, 6, 8) / Float64{2} == Vector4f64(1, 2, 3, 4));
+static_assert(Vector4f64(1, 2, 3, 4) != Vector4f64(1, 2, 3, 5));
+static_assert(Dot(Vector4f64(1, 2, 3, 4), Vector4f64(5, 6, 7, 8)) == 70);
+static_assert(Vector4f64(1, 2, 3, 4).SquaredLength() == 30);
+
+// std::sqrt is constexpr from C++26 on, GCC already folds it
+#if (defined(__cpp_lib_constexpr_cmath) && __cpp_lib_constexpr_cmath >= 202306L) || \
+    (defined(__GNUC__) && !defined(__clang__))
+static_assert(Vector3f32(3, 0, 4).Length() == 5);
+static_assert(Vector3f32(3, 0, 4).Normalized() == Vector3f32(0.6f, 0, 0.8f));
+static_assert(Vector4f32(2, 2, 2, 2).Length() == 4);
+static_assert(Vector4f32(2, 2, 2, 2).Normalized() == Vector4f32(0.5f, 0.5f, 0.5f, 0.5f));
+static_assert(Vector4f64(2, 2, 2, 2).Length() == 4);
+static_assert(Vector4f64(2, 2, 2, 2).Normalized() == Vector4f64(0.5, 0.5, 0.5, 0.5));
+#endif
+
+// Behaves like T but is a different type, so Vector3<Reference<T>> and Vector4<Reference<T>>
+// always instantiate the generic templates, whatever is specialized for T
+template <typename T>
+struct Reference
+{
+    constexpr Reference() = default;
+    constexpr Reference(T value)
+        : value{value}
+    {
+    }
+
+    constexpr operator T() const { return value; }
+
+    constexpr Reference& operator+=(Reference rhs)
+    {
+        value += rhs.value;
+        return *this;
+    }
+
+    constexpr Reference& operator-=(Reference rhs)
+    {
+        value -= rhs.value;
+        return *this;
+    }
+
+    constexpr Reference& operator*=(Reference rhs)
+    {
+        value *= rhs.value;
+        return *this;
+    }
+
+    constexpr Reference& operator/=(Reference rhs)
+    {
+        value /= rhs.value;
+        return *this;
+    }
+
+    T value{};
+};
+
+template <typename T>
+std::array<T, 3> Components(const Vector3<T>& vector)
+{
+    return {vector.x, vector.y, vector.z};
+}
+
+template <typename T>
+std::array<T, 4> Components(const Vector4<T>& vector)
+{
+    return {vector.x, vector.y, vector.z, vector.w};
+}
+
+template <template <typename> typename Vector, typename T>
+Vector<Reference<T>> ToReference(const Vector<T>& vector)
+{
+    return std::apply([](auto... components) { return Vector<Reference<T>>(components...); },
+                      Components(vector));
+}
+
+template <typename T>
+[[nodiscard]] bool SameBits(T actual, Reference<T> expected)
+{
+    using Bits = std::conditional_t<sizeof(T) == 4, UInt32, UInt64>;
+    if (std::isnan(actual) || std::isnan(expected.value))
+        return std::isnan(actual) && std::isnan(expected.value);
+    return std::bit_cast<Bits>(actual) == std::bit_cast<Bits>(expected.value);
+}
+
+template <template <typename> typename Vector, typename T>
+[[nodiscard]] bool SameBits(const Vector<T>& actual, const Vector<Reference<T>>& expected)
+{
+    const auto actualComponents   = Components(actual);
+    const auto expectedComponents = Components(expected);
+    for (UInt64 i = 0; i < actualComponents.size(); i++)
+        if (!SameBits(actualComponents[i], expectedComponents[i])) return false;
+    return true;
+}
+
+// Mostly moderate magnitudes with a spread of exponents, plus the values that tend to break
+// vector code: signed zeros, denormals, huge values that overflow once multiplied
+template <typename T>
+class ValueSource
+{
+public:
+    explicit ValueSource(UInt32 seed)
+        : _random{seed}
+    {
+    }
+
+    T Next()
+    {
+        static constexpr T Specials[] = {T{0},
+                                         -T{0},
+                                         T{1},
+                                         -T{1},
+                                         std::numeric_limits<T>::denorm_min(),
+                                         std::numeric_limits<T>::min(),
+                                         std::numeric_limits<T>::max() / T{4},
+                                         std::numeric_limits<T>::epsilon()};
+
+        if (std::uniform_int_distribution<UInt32>(0, 15)(_random) == 0)
+            return Specials[std::uniform_int_distribution<UInt64>(0, std::size(Specials) - 1)(
+                _random)];
+
+        const double mantissa = std::uniform_real_distribution<double>(-1.0, 1.0)(_random);
+        const int exponent    = std::uniform_int_distribution<int>(-20, 20)(_random);
+        return static_cast<T>(std::ldexp(mantissa, exponent));
+    }
+
+private:
+    std::mt19937 _random;
+};
+
+template <template <typename> typename Vector, typename T>
+Vector<T> NextVector(ValueSource<T>& source)
+{
+    if constexpr (std::is_same_v<Vector<T>, Vector3<T>>)
+        return Vector<T>(source.Next(), source.Next(), source.Next());
+    else
+        return Vector<T>(source.Next(), source.Next(), source.Next(), source.Next());
+}
+
+template <template <typename> typename Vector, typename T>
+void CheckAgainstGeneric(const Vector<T>& lhs, const Vector<T>& rhs, T scalar)
+{
+    using R                      = Reference<T>;
+    const Vector<R> referenceLhs = ToReference(lhs);
+    const Vector<R> referenceRhs = ToReference(rhs);
+    const R referenceScalar{scalar};
+
+    TEZ_CHECK(SameBits(-lhs, -referenceLhs));
+    TEZ_CHECK(SameBits(lhs + rhs, referenceLhs + referenceRhs));
+    TEZ_CHECK(SameBits(lhs - rhs, referenceLhs - referenceRhs));
+    TEZ_CHECK(SameBits(lhs * rhs, referenceLhs * referenceRhs));
+    TEZ_CHECK(SameBits(scalar * lhs, referenceScalar * referenceLhs));
+    TEZ_CHECK(SameBits(lhs * scalar, referenceLhs * referenceScalar));
+
+    Vector<T> compound          = lhs;
+    Vector<R> referenceCompound = referenceLhs;
+    compound += rhs;
+    referenceCompound += referenceRhs;
+    TEZ_CHECK(SameBits(compound, referenceCompound));
+    compound -= lhs;
+    referenceCompound -= referenceLhs;
+    TEZ_CHECK(SameBits(compound, referenceCompound));
+    compound *= scalar;
+    referenceCompound *= referenceScalar;
+    TEZ_CHECK(SameBits(compound, referenceCompound));
+
+    if (scalar != 0)
+    {
+        TEZ_CHECK(SameBits(lhs / scalar, referenceLhs / referenceScalar));
+        compound /= scalar;
+        referenceCompound /= referenceScalar;
+        TEZ_CHECK(SameBits(compound, referenceCompound));
+    }
+
+    TEZ_CHECK((lhs == rhs) == (referenceLhs == referenceRhs));
+    TEZ_CHECK((lhs != rhs) == (referenceLhs != referenceRhs));
+    TEZ_CHECK((lhs == lhs) == (referenceLhs == referenceLhs));
+
+    TEZ_CHECK(SameBits(Dot(lhs, rhs), Dot(referenceLhs, referenceRhs)));
+    TEZ_CHECK(SameBits(lhs.SquaredLength(), referenceLhs.SquaredLength()));
+    TEZ_CHECK(SameBits(lhs.Length(), referenceLhs.Length()));
+    if (lhs.Length() != 0) TEZ_CHECK(SameBits(lhs.Normalized(), referenceLhs.Normalized()));
+
+    if constexpr (std::is_same_v<Vector<T>, Vector3<T>>)
+        TEZ_CHECK(SameBits(Cross(lhs, rhs), Cross(referenceLhs, referenceRhs)));
+}
+
+template <template <typename> typename Vector, typename T>
+void TestVector(const Char* name, UInt32 seed)
+{
+    constexpr UInt32 Cases = 100000;
+
+    const UInt64 failuresBefore = Tests::failureCount.load(std::memory_order_relaxed);
+    ValueSource<T> source(seed);
+    for (UInt32 i = 0; i < Cases; i++)
+    {
+        const Vector<T> lhs = NextVector<Vector>(source);
+        const Vector<T> rhs = NextVector<Vector>(source);
+        CheckAgainstGeneric(lhs, rhs, source.Next());
+    }
+
+    // Exactly equal operands take the all lanes equal path of operator==
+    const Vector<T> same = NextVector<Vector>(source);
+    CheckAgainstGeneric(same, same, T{1});
+
+    const UInt64 failures = Tests::failureCount.load(std::memory_order_relaxed) - failuresBefore;
+    std::printf("%s: %u cases, %llu failed checks\n", name, Cases,
+                static_cast<unsigned long long>(failures));
+}
+} // namespace
+} // namespace Tez
+
+int main()
+{
+    using namespace Tez;
+
+#if defined(TEZ_SIMD_AVX2)
+    #if defined(__GNUC__) || defined(__clang__)
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        std::printf("The CPU lacks AVX2, skipped\n");
+        return Tests::SkipExitCode;
+    }
+    #endif
+    std::printf("Testing the AVX2 specializations\n");
+#elif defined(TEZ_SIMD_SSE)
+    std::printf("Testing the SSE specializations\n");
+#else
+    std::printf("Testing the generic templates\n");
+#endif
+
+    TestVector<Vector3, Float32>("Vector3f32", 1);
+    TestVector<Vector4, Float32>("Vector4f32", 2);
+    TestVector<Vector4, Float64>("Vector4f64", 3);
+
+    return Tests::Result();
+}
@@ -45,3 +45,86 @@ function(tez_lib_target TARGET_NAME)
 		OUTPUT_NAME_DEBUG "${LIBRARY_TARGET}-d"
 		PREFIX "")
 endfunction()
+
+# Executable named tez-<name>, runs through the tez-<name>-run target which writes
+# tez-<name>.json into the build directory
+function(tez_benchmark_target TARGET_NAME)
+	string(TOLOWER "${TARGET_NAME}" TARGET_NAME_LOWER)
+	set(BENCHMARK_TARGET "tez-${TARGET_NAME_LOWER}")
+	add_executable(${BENCHMARK_TARGET})
+
+	cmake_parse_arguments(
+		ARG
+		""
+		""
+		"SOURCES;PRIVATE_DEPENDENCIES;PRIVATE_INCLUDES"
+		${ARGN}
+				)
+
+	if(ARG_SOURCES)
+		target_sources(${BENCHMARK_TARGET} PRIVATE ${ARG_SOURCES})
+	endif()
+
+	if(ARG_PRIVATE_INCLUDES)
+		target_include_directories(${BENCHMARK_TARGET} PRIVATE ${ARG_PRIVATE_INCLUDES})
+	endif()
+
+	if(ARG_PRIVATE_DEPENDENCIES)
+		target_link_libraries(${BENCHMARK_TARGET} PRIVATE ${ARG_PRIVATE_DEPENDENCIES})
+	endif()
+
+	# Recorded in the results, numbers from unoptimized builds aren't comparable
+	target_compile_definitions(${BENCHMARK_TARGET} PRIVATE TEZ_BENCHMARK_CONFIG="$<CONFIG>")
+
+	set_target_properties(${BENCHMARK_TARGET} PROPERTIES
+		OUTPUT_NAME "${BENCHMARK_TARGET}"
+		OUTPUT_NAME_DEBUG "${BENCHMARK_TARGET}-d")
+
+	add_custom_target(${BENCHMARK_TARGET}-run
+		COMMAND ${BENCHMARK_TARGET} --json ${CMAKE_BINARY_DIR}/${BENCHMARK_TARGET}.json
+		DEPENDS ${BENCHMARK_TARGET}
+		USES_TERMINAL)
+endfunction()
+
+# Executable named tez-<name>-tests, registered with CTest under the same name. Exiting with 77
+# reports the test as skipped.
+function(tez_test_target TARGET_NAME)
+	string(TOLOWER "${TARGET_NAME}" TARGET_NAME_LOWER)
+	set(TEST_TARGET "tez-${TARGET_NAME_LOWER}-tests")
+	add_executable(${TEST_TARGET})
+
+	cmake_parse_arguments(
+		ARG
+		""
+		""
+		"SOURCES;PRIVATE_DEPENDENCIES;PRIVATE_INCLUDES;PRIVATE_DEFINITIONS;PRIVATE_OPTIONS"
+		${ARGN}
+				)
+
+	if(ARG_SOURCES)
+		target_sources(${TEST_TARGET} PRIVATE ${ARG_SOURCES})
+	endif()
+
+	if(ARG_PRIVATE_INCLUDES)
+		target_include_directories(${TEST_TARGET} PRIVATE ${ARG_PRIVATE_INCLUDES})
+	endif()
+
+	if(ARG_PRIVATE_DEPENDENCIES)
+		target_link_libraries(${TEST_TARGET} PRIVATE ${ARG_PRIVATE_DEPENDENCIES})
+	endif()
+
+	if(ARG_PRIVATE_DEFINITIONS)
+		target_compile_definitions(${TEST_TARGET} PRIVATE ${ARG_PRIVATE_DEFINITIONS})
+	endif()
+
+	if(ARG_PRIVATE_OPTIONS)
+		target_compile_options(${TEST_TARGET} PRIVATE ${ARG_PRIVATE_OPTIONS})
+	endif()
+
+	set_target_properties(${TEST_TARGET} PROPERTIES
+		OUTPUT_NAME "${TEST_TARGET}"
+		OUTPUT_NAME_DEBUG "${TEST_TARGET}-d")
+
+	add_test(NAME ${TEST_TARGET} COMMAND ${TEST_TARGET})
+	set_tests_properties(${TEST_TARGET} PROPERTIES SKIP_RETURN_CODE 77)
+endfunction()